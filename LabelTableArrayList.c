@@ -16,6 +16,12 @@
  *                            (e.g., findLabel => findLabelAddr,
  *                             if ( ! table ) => if ( table == NULL ), etc)
  *   Modified:   2/22/2022   Finished all the functions. 
+ *   Modified:  10/19/2026   Allocate from the table's arena, if it has
+ *                           one; added tableInitInArena and tableFree.
+ *   Modified:  10/19/2026   Store the table as parallel arrays with one
+ *                            string pool and a hash index.
+ *   Modified:  10/19/2026   findLabelAddr falls back on the table of
+ *                            imported labels.
  *
  * 
 */
@@ -26,8 +32,13 @@
 static const char * ERROR0 = "Error: label table is a NULL pointer.\n";
 static const char * ERROR1 = "Error: a duplicate label was found.\n";
 static const char * ERROR2 = "Error: cannot allocate space in memory.\n";
-// internal function (visible to this file only)
+// internal functions (visible to this file only)
 static int verifyTableExists(LabelTableArrayList * table);
+static void * tableRealloc(LabelTableArrayList * table, void * memory,
+                           size_t oldSize, size_t newSize);
+static void tableRelease(LabelTableArrayList * table, void * memory);
+static int growPool(LabelTableArrayList * table, unsigned int needed);
+static int rebuildIndex(LabelTableArrayList * table, int numSlots);
 
 void tableInit (LabelTableArrayList * table)
   /* Postcondition: table is initialized to indicate that there
@@ -41,11 +52,60 @@ void tableInit (LabelTableArrayList * table)
         /* initialize as empty table, must grow right off the bat */
         table->capacity = 0;
         table->nbrLabels = 0;
-        table->entries = NULL;
+        table->hashes = NULL;
+        table->offsets = NULL;
+        table->lengths = NULL;
+        table->addresses = NULL;
+        table->pool = NULL;
+        table->poolSize = 0;
+        table->poolCapacity = 0;
+        table->slots = NULL;
+        table->numSlots = 0;
+        table->arena = NULL;
+        table->imported = NULL;
 
 
 }
 
+void tableInitInArena (LabelTableArrayList * table, Arena * arena)
+  /* Postcondition: table is initialized to indicate that there
+   *       are no label entries in it; its entries and label
+   *       names will be allocated from arena.
+   */
+{
+        tableInit (table);
+        if ( table != NULL )
+            table->arena = arena;
+}
+
+void tableFree (LabelTableArrayList * table)
+  /* Postcondition: the memory used by the table's entries and
+   *       label names has been released (unless it belongs to an
+   *       arena) and the table is empty.
+   */
+{
+        Arena * arena;
+        LabelTableArrayList * imported;
+
+        /* verify that table exists */
+        if ( ! verifyTableExists (table) )
+            return;           /* fatal error: table doesn't exist */
+
+        /* An arena releases everything at once when it is freed. */
+        tableRelease (table, table->hashes);
+        tableRelease (table, table->offsets);
+        tableRelease (table, table->lengths);
+        tableRelease (table, table->addresses);
+        tableRelease (table, table->pool);
+        tableRelease (table, table->slots);
+
+        arena = table->arena;
+        imported = table->imported;
+        tableInit (table);
+        table->arena = arena;
+        table->imported = imported;
+}
+
 void printLabels (LabelTableArrayList * table)
   /* Postcondition: all the labels in the table, with their
    *      associated addresses, have been printed to the standard
@@ -62,28 +122,91 @@ void printLabels (LabelTableArrayList * table)
                                 table->nbrLabels);
 
         for (i = 0; i < table->nbrLabels; i++) //print all labels in the table
-            printf("\tLabel: %s, Instruction address: %d. \n", table->entries[i].label,table->entries[i].address);
+            printf("\tLabel: %s, Instruction address: %d. \n", tableLabelName(table, i),table->addresses[i]);
 
 }
 
 int findLabelAddr (LabelTableArrayList * table, char * label)
-  /* Returns the address associated with the label; -1 if label is
-   *      not in the table or table doesn't exist
+  /* Returns the address associated with the label (looking in the
+   *      table of imported labels if it is not in the table); -1 if
+   *      label is in neither or table doesn't exist
+   */
+{
+        int index = findLabelIndex (table, label);
+
+        if ( index == -1 && table != NULL && table->imported != NULL )
+            return findLabelAddr (table->imported, label);
+        if ( index == -1 )
+            return -1;      /* lable was not found in the table. */
+
+        return table->addresses[index];
+}
+
+int findLabelIndex (LabelTableArrayList * table, const char * label)
+  /* Returns the entry number of the label in the table; -1 if label
+   *      is not in the table or table doesn't exist
    */
 {
+        unsigned int hash, length;
         int i;
 
         /* verify that table exists */
         if ( ! verifyTableExists (table) )
             return -1;           /* fatal error: table doesn't exist */
 
-        for (i = 0; i < table->nbrLabels; i++) //go through all lables in table
-            if(strcmp(table->entries[i].label,label) == SAME) //compare lable
-                return table->entries[i].address;
-        
+        hash = labelHash (label, &length);
+
+        /* Without an index, compare against every entry. */
+        if ( table->numSlots == 0 )
+        {
+            for (i = 0; i < table->nbrLabels; i++) //go through all lables in table
+                if ( table->hashes[i] == hash && table->lengths[i] == length &&
+                     memcmp (table->pool + table->offsets[i], label,
+                             length) == SAME )
+                    return i;
+            return -1;  /* lable was not found in the table. */
+        }
+
+        /* Probe the index, starting at the slot the hash selects. */
+        unsigned int mask = table->numSlots - 1;
+        for (i = hash & mask; table->slots[i] != 0; i = (i + 1) & mask)
+        {
+            int entry = table->slots[i] - 1;
+            if ( table->hashes[entry] == hash &&
+                 table->lengths[entry] == length &&
+                 memcmp (table->pool + table->offsets[entry], label,
+                         length) == SAME )
+                return entry;
+        }
+
         return -1;      /* lable was not found in the table. */
 }
 
+const char * tableLabelName (LabelTableArrayList * table, int index)
+  /* Returns the name of the label in entry number index.
+   */
+{
+        return table->pool + table->offsets[index];
+}
+
+unsigned int labelHash (const char * label, unsigned int * length)
+  /* Returns the 32-bit FNV-1a hash of label and sets *length to the
+   *      length of label.
+   */
+{
+        unsigned int hash = 2166136261u;
+        const char * c;
+
+        for (c = label; *c != '\0'; c++)
+        {
+            hash ^= (unsigned char) *c;
+            hash *= 16777619u;
+        }
+
+        *length = c - label;
+        return hash;
+}
+
 int addLabel (LabelTableArrayList * table, char * label, int progCounter)
   /* Postcondition: if label was already in table, the table is 
    *      unchanged; otherwise a new entry has been added to the 
@@ -93,14 +216,15 @@ int addLabel (LabelTableArrayList * table, char * label, int progCounter)
    *      or table doesn't exist.
    */
 {
-        char * duplLabelName;
+        unsigned int hash, length;
+        int entry;
 
         /* verify that table exists */
         if ( ! verifyTableExists (table) )
             return 0;           /* fatal error: table doesn't exist */
 
         /* Was the label already in the table? */
-        if ( findLabelAddr(table, label) != -1 )  
+        if ( findLabelIndex(table, label) != -1 )  
         {
             /* This is an error (ERROR1), but not a fatal one.
              * Report error; don't add the label to the table again. 
@@ -109,14 +233,6 @@ int addLabel (LabelTableArrayList * table, char * label, int progCounter)
             return 1;
         }
 
-        /* Create a dynamically allocated version of label that will persist. */
-        /*   NOTE: on some machines you may need to make this _strdup !  */
-        if ((duplLabelName = strdup (label)) == NULL)
-        {
-            printError ("%s", ERROR2);
-            return 0;           /* fatal error: couldn't allocate memory */
-        }
-
         /* Resize the table if necessary. */
         if ( table->nbrLabels >= table->capacity )
         {
@@ -130,10 +246,33 @@ int addLabel (LabelTableArrayList * table, char * label, int progCounter)
              }
             
         }
-        table->entries[table->nbrLabels].label = duplLabelName;
-        table->entries[table->nbrLabels].address = progCounter;
+
+        /* Keep the index at most half full. */
+        if ( 2 * (table->nbrLabels + 1) > table->numSlots &&
+             ! rebuildIndex (table, table->numSlots * 2) )
+            return 0;           /* fatal error: couldn't allocate memory */
+
+        /* Copy the label name (and its null byte) into the pool. */
+        hash = labelHash (label, &length);
+        if ( ! growPool (table, length + 1) )
+            return 0;           /* fatal error: couldn't allocate memory */
+        memcpy (table->pool + table->poolSize, label, length + 1);
+
+        entry = table->nbrLabels;
+        table->hashes[entry] = hash;
+        table->offsets[entry] = table->poolSize;
+        table->lengths[entry] = length;
+        table->addresses[entry] = progCounter;
+        table->poolSize += length + 1;
         table->nbrLabels++;
 
+        /* Add the new entry to the index. */
+        unsigned int mask = table->numSlots - 1;
+        unsigned int slot = hash & mask;
+        while ( table->slots[slot] != 0 )
+            slot = (slot + 1) & mask;
+        table->slots[slot] = entry + 1;
+
         return 1;               /* everything worked great! */
 }
 
@@ -146,37 +285,98 @@ int tableResize (LabelTableArrayList * table, int newSize)
    *      or table doesn't exist.
    */
 {
-        LabelEntry * newEntryList;
-        int          smaller;
+        unsigned int * newHashes, * newOffsets, * newLengths;
+        int          * newAddresses;
+        size_t         oldSize, size;
 
         /* verify that table exists */
         if ( ! verifyTableExists (table) )
             return 0;           /* fatal error: table doesn't exist */
 
-        /* create a new internal table of the specified size */
-        if ((newEntryList = malloc (newSize * sizeof(LabelEntry))) == NULL)
+        /* resize each internal array, keeping its contents; growing an
+         * array in place (when possible) avoids copying it
+         */
+        oldSize = table->capacity * sizeof(int);
+        size = newSize * sizeof(int);
+        newHashes = tableRealloc (table, table->hashes, oldSize, size);
+        if ( newHashes != NULL )
+            table->hashes = newHashes;
+        newOffsets = tableRealloc (table, table->offsets, oldSize, size);
+        if ( newOffsets != NULL )
+            table->offsets = newOffsets;
+        newLengths = tableRealloc (table, table->lengths, oldSize, size);
+        if ( newLengths != NULL )
+            table->lengths = newLengths;
+        newAddresses = tableRealloc (table, table->addresses, oldSize, size);
+        if ( newAddresses != NULL )
+            table->addresses = newAddresses;
+        if ( newHashes == NULL || newOffsets == NULL || newLengths == NULL ||
+             newAddresses == NULL )
         {
             printError ("%s", ERROR2);
             return 0;           /* fatal error: couldn't allocate memory */
         }
 
-        if ( table->entries != NULL )           /* if there were entries */
+        table->capacity = newSize;
+
+        /* Truncate the table if it is smaller than before.  The index
+         * must then be rebuilt without the entries that were dropped.
+         */
+        if ( table->nbrLabels > newSize )
         {
-            /* move contents of internal table to new internal table */
-            smaller = table->nbrLabels < newSize ? table->nbrLabels : newSize;
-            (void) memcpy (newEntryList, table->entries,
-                           smaller * sizeof(LabelEntry));
-
-            /* free the space taken up by the old internal table */
-            free (table->entries);
-            table->nbrLabels = smaller;
+            table->nbrLabels = newSize;
+            return rebuildIndex (table, table->numSlots);
         }
+        if ( table->numSlots == 0 )
+            return rebuildIndex (table, 16);
+        return 1;
+}
 
-        table->entries = newEntryList;
-        table->capacity = newSize;
+int tableCompact (LabelTableArrayList * table)
+  /* Postcondition: the table's storage has been shrunk to fit the
+   *      labels it holds (the table may still grow afterwards).
+   * Returns 1 if everything went OK; 0 if memory allocation error
+   *      or table doesn't exist.
+   */
+{
+        char * newPool;
+        int    numSlots = 16;
+
+        /* verify that table exists */
+        if ( ! verifyTableExists (table) )
+            return 0;           /* fatal error: table doesn't exist */
+        if ( table->nbrLabels == 0 )
+            return 1;
+
+        /* Shrink the entries and the pool to fit. */
+        if ( ! tableResize (table, table->nbrLabels) )
+            return 0;
+        newPool = tableRealloc (table, table->pool, table->poolCapacity,
+                                table->poolSize);
+        if ( newPool == NULL )
+        {
+            printError ("%s", ERROR2);
+            return 0;
+        }
+        table->pool = newPool;
+        table->poolCapacity = table->poolSize;
+
+        /* Keep the index at most half full, but no bigger. */
+        while ( numSlots < 2 * table->nbrLabels )
+            numSlots *= 2;
+        if ( numSlots < table->numSlots )
+            return rebuildIndex (table, numSlots);
         return 1;
 }
 
+size_t tableBytes (LabelTableArrayList * table)
+  /* Returns the number of bytes of storage the table is using.
+   */
+{
+        return (size_t) table->capacity * 4 * sizeof(int) +
+               table->poolCapacity + (size_t) table->numSlots * sizeof(int);
+}
+
 static int verifyTableExists(LabelTableArrayList * table)
  /* Returns true (1) if table exists (pointer is non-null); prints an error
   * and returns false (0) otherwise.
@@ -191,3 +391,83 @@ static int verifyTableExists(LabelTableArrayList * table)
 
         return 1;
 }
+
+static void * tableRealloc(LabelTableArrayList * table, void * memory,
+                           size_t oldSize, size_t newSize)
+ /* Resizes memory (which holds oldSize bytes, or is NULL) to newSize
+  * bytes, using the table's arena or, if the table has no arena,
+  * realloc.  Returns the resized memory; NULL if memory allocation error.
+  */
+{
+        if ( table->arena != NULL )
+            return arenaRealloc (table->arena, memory, oldSize, newSize);
+        return realloc (memory, newSize);
+}
+
+static void tableRelease(LabelTableArrayList * table, void * memory)
+ /* Frees memory obtained from tableRealloc, unless it belongs to an arena.
+  */
+{
+        if ( table->arena == NULL )
+            free (memory);
+}
+
+static int growPool(LabelTableArrayList * table, unsigned int needed)
+ /* Makes sure the pool has room for needed more bytes.
+  * Returns 1 if everything went OK; 0 if memory allocation error.
+  */
+{
+        unsigned int newCapacity;
+        char       * newPool;
+
+        if ( table->poolSize + needed <= table->poolCapacity )
+            return 1;
+
+        newCapacity = table->poolCapacity * 2 + 256;
+        while ( newCapacity < table->poolSize + needed )
+            newCapacity *= 2;
+
+        /* Entries refer to names by offset, so moving the pool is safe. */
+        newPool = tableRealloc (table, table->pool, table->poolCapacity,
+                                newCapacity);
+        if ( newPool == NULL )
+        {
+            printError ("%s", ERROR2);
+            return 0;           /* fatal error: couldn't allocate memory */
+        }
+        table->pool = newPool;
+        table->poolCapacity = newCapacity;
+        return 1;
+}
+
+static int rebuildIndex(LabelTableArrayList * table, int numSlots)
+ /* Rebuilds the table's index with numSlots slots (a power of two)
+  * containing all of the table's entries.
+  * Returns 1 if everything went OK; 0 if memory allocation error.
+  */
+{
+        int * newSlots = tableRealloc (table, table->slots,
+                                       table->numSlots * sizeof(int),
+                                       numSlots * sizeof(int));
+        unsigned int mask = numSlots - 1;
+        int i;
+
+        if ( newSlots == NULL )
+        {
+            printError ("%s", ERROR2);
+            return 0;           /* fatal error: couldn't allocate memory */
+        }
+        (void) memset (newSlots, 0, numSlots * sizeof(int));
+
+        for (i = 0; i < table->nbrLabels; i++)
+        {
+            unsigned int slot = table->hashes[i] & mask;
+            while ( newSlots[slot] != 0 )
+                slot = (slot + 1) & mask;
+            newSlots[slot] = i + 1;
+        }
+
+        table->slots = newSlots;
+        table->numSlots = numSlots;
+        return 1;
+}
@@ -11,27 +11,59 @@
  * Creation Date:   2/16/99
  *   Modified:  12/20/2000   Updated postcondition information.
  *   Modified:  2/24/2021    Changed findLabel => findLabelAddr for readability
+ *   Modified:  10/19/2026   Tables can keep their storage in an arena;
+ *                           added tableFree.
+ *   Modified:  10/19/2026   Struct-of-arrays storage with a string pool
+ *                           and hash index; added labelHash,
+ *                           findLabelIndex, and tableLabelName.
+ *   Modified:  10/19/2026   Added tableCompact and tableBytes.
+ *   Modified:  10/19/2026   A table may fall back on a table of imported
+ *                           labels (see symbolMap.h).
  *
 */
 
 #ifndef LABEL_H
 #define LABEL_H
 
+#include "arena.h"
+
 /* THE DATA STRUCTURES */
 
-/* The first type definition defines the type for a single entry in the
- * table.  The second defines the type for the table as a whole.
+/* The table is stored as a set of parallel arrays ("struct of arrays"):
+ * entry i of the table is made up of hashes[i], offsets[i], lengths[i],
+ * and addresses[i].  The label names themselves are stored one after
+ * another, each followed by a null byte, in a single string pool; entry
+ * i's name starts at pool + offsets[i].  A lookup compares the hash and
+ * length of a label before it ever looks at the bytes of its name, and
+ * never has to follow a pointer to a separately allocated string.
+ *
+ * The table also keeps a hash index (open addressing with linear
+ * probing) so that lookups do not have to scan every entry.  Each slot
+ * holds an entry number plus one, or 0 if the slot is empty.  A table
+ * without an index (numSlots == 0) is searched entry by entry.
+ *
+ * A label that is not in the table may still be found in the table of
+ * imported labels, if there is one: labels defined by some other
+ * assembly, read from a symbol map (see symbolMap.h).  A label in the
+ * table hides an imported label with the same name.
  */
 
-typedef struct {
-        char * label;           /* label name */
-        int   address;           /* address of label */
-} LabelEntry;
-
-typedef struct {
+typedef struct LabelTable {
         int capacity;           /* capacity of the table */
         int nbrLabels;          /* actual nbr of entries in table */
-        LabelEntry * entries;
+        unsigned int * hashes;  /* hash of each label name */
+        unsigned int * offsets; /* offset of each label name in pool */
+        unsigned int * lengths; /* length of each label name */
+        int * addresses;        /* address of each label */
+        char * pool;            /* all label names, null-terminated */
+        unsigned int poolSize;      /* bytes of pool in use */
+        unsigned int poolCapacity;  /* bytes allocated for pool */
+        int * slots;            /* hash index into the entries */
+        int numSlots;           /* number of slots; a power of two */
+        Arena * arena;          /* arena holding the table's storage,
+                                   or NULL if it is malloc'ed */
+        struct LabelTable * imported;   /* labels defined elsewhere, or
+                                           NULL */
 } LabelTableArrayList;
 
 
@@ -42,6 +74,19 @@ void tableInit (LabelTableArrayList * table);
          *       are no label entries in it.
          */
 
+void tableInitInArena (LabelTableArrayList * table, Arena * arena);
+        /* Postcondition: table is initialized to indicate that there
+         *       are no label entries in it; its entries and label
+         *       names will be allocated from arena, so they are
+         *       released when the arena is freed.
+         */
+
+void tableFree (LabelTableArrayList * table);
+        /* Postcondition: the memory used by the table's entries and
+         *       label names has been released (unless it belongs to an
+         *       arena, which releases it instead) and the table is empty.
+         */
+
 int tableResize (LabelTableArrayList * table, int newSize);
         /* Postcondition: table now has the capacity to hold newSize
          *      label entries.  If the new size is smaller than the
@@ -60,9 +105,37 @@ int addLabel (LabelTableArrayList * table, char * labelName, int progCounter);
          *      or table doesn't exist.
          */
 
+int tableCompact (LabelTableArrayList * table);
+        /* Postcondition: the table's storage has been shrunk to fit the
+         *      labels it holds (the table may still grow afterwards).
+         * Returns 1 if everything went OK; 0 if memory allocation error
+         *      or table doesn't exist.
+         */
+
+size_t tableBytes (LabelTableArrayList * table);
+        /* Returns the number of bytes of storage the table is using.
+         */
+
 int findLabelAddr (LabelTableArrayList * table, char * label);
-        /* Returns the address associated with the label; -1 if label is
-         *      not in the table or if table doesn't exist
+        /* Returns the address associated with the label (looking in the
+         *      table of imported labels if it is not in the table); -1
+         *      if label is in neither or if table doesn't exist
+         */
+
+int findLabelIndex (LabelTableArrayList * table, const char * label);
+        /* Returns the entry number of the label in the table; -1 if
+         *      label is not in the table (imported labels are not
+         *      searched) or if table doesn't exist
+         */
+
+const char * tableLabelName (LabelTableArrayList * table, int index);
+        /* Returns the name of the label in entry number index.
+         */
+
+unsigned int labelHash (const char * label, unsigned int * length);
+        /* Returns the hash of label (32-bit FNV-1a) and sets *length to
+         *      the length of label.  Tables saved to files rely on this
+         *      hash, so it must not change.
          */
 
 void printLabels (LabelTableArrayList * table);
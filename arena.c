@@ -0,0 +1,200 @@
+/*
+ * Arena: functions to allocate from and release a bump-pointer arena.
+ *
+ * See arena.h for a description of how an arena behaves.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+#include "printFuncs.h"
+
+/* Every block starts with this header; its memory follows it. */
+struct ArenaBlock {
+        ArenaBlock * next;      /* next (older) block */
+        size_t capacity;        /* bytes of memory in this block */
+        size_t used;            /* bytes already handed out */
+        int    dedicated;       /* holds one oversized allocation */
+        max_align_t  memory[];  /* start of the block's memory */
+};
+
+static const char * ERROR = "Error: cannot allocate space in memory.\n";
+
+/* Obtains a new block of at least minSize bytes and makes it the
+ * current block.  Returns NULL if memory allocation error.
+ */
+static ArenaBlock * newBlock(Arena * arena, size_t minSize);
+
+void arenaInit (Arena * arena, size_t blockSize)
+{
+        arena->blocks = NULL;
+        arena->blockSize = blockSize > 0 ? blockSize
+                                         : ARENA_DEFAULT_BLOCK_SIZE;
+        arena->numAllocs = 0;
+        arena->numBlocks = 0;
+        arena->bytesUsed = 0;
+        arena->bytesReserved = 0;
+        arena->peakReserved = 0;
+}
+
+static void * allocAligned (Arena * arena, size_t size, size_t alignment)
+{
+        ArenaBlock * block = arena->blocks;
+        size_t       start;
+
+        /* Find the first suitably aligned offset in the current block. */
+        if ( block != NULL )
+        {
+            start = (block->used + alignment - 1) & ~(alignment - 1);
+            if ( start + size <= block->capacity )
+            {
+                arena->bytesUsed += start + size - block->used;
+                block->used = start + size;
+                arena->numAllocs++;
+                return (char *) block->memory + start;
+            }
+        }
+
+        /* Didn't fit; start a new block.  Its memory is always aligned. */
+        if ( (block = newBlock(arena, size)) == NULL )
+            return NULL;
+        block->used = size;
+        arena->bytesUsed += size;
+        arena->numAllocs++;
+        return block->memory;
+}
+
+void * arenaAlloc (Arena * arena, size_t size)
+{
+        return allocAligned(arena, size, sizeof(max_align_t));
+}
+
+void * arenaRealloc (Arena * arena, void * memory, size_t oldSize,
+                     size_t newSize)
+{
+        ArenaBlock ** link;
+        ArenaBlock  * block;
+        void        * copy;
+
+        if ( memory == NULL )
+            return arenaAlloc(arena, newSize);
+        if ( newSize == oldSize )
+            return memory;
+
+        /* Find the block holding memory, if it has a block of its own. */
+        for ( link = &arena->blocks; *link != NULL; link = &(*link)->next )
+            if ( (void *) (*link)->memory == memory && (*link)->dedicated )
+                break;
+
+        if ( (block = *link) != NULL && newSize > 0 )
+        {
+            /* Resize the dedicated block in place (if realloc can). */
+            block = realloc(block, sizeof(ArenaBlock) + newSize);
+            if ( block == NULL )
+            {
+                printError("%s", ERROR);
+                return NULL;
+            }
+            *link = block;
+            arena->bytesReserved += newSize - block->capacity;
+            arena->bytesUsed += newSize - block->used;
+            block->capacity = block->used = newSize;
+            if ( arena->bytesReserved > arena->peakReserved )
+                arena->peakReserved = arena->bytesReserved;
+            return block->memory;
+        }
+        if ( newSize < oldSize )
+            return memory;      /* shared blocks never shrink */
+
+        /* Was memory the most recent allocation in the current block?
+         * If there is room, just extend it.
+         */
+        block = arena->blocks;
+        if ( block != NULL && ! block->dedicated &&
+             (char *) memory + oldSize ==
+                 (char *) block->memory + block->used &&
+             block->used - oldSize + newSize <= block->capacity )
+        {
+            block->used += newSize - oldSize;
+            arena->bytesUsed += newSize - oldSize;
+            return memory;
+        }
+
+        /* Otherwise copy it to a new allocation. */
+        if ( (copy = arenaAlloc(arena, newSize)) != NULL )
+            memcpy(copy, memory, oldSize);
+        return copy;
+}
+
+char * arenaStrdup (Arena * arena, const char * string)
+{
+        size_t length = strlen(string) + 1;
+        char * copy = allocAligned(arena, length, 1);
+
+        if ( copy != NULL )
+            memcpy(copy, string, length);
+        return copy;
+}
+
+void arenaFree (Arena * arena)
+{
+        ArenaBlock * block = arena->blocks;
+
+        while ( block != NULL )
+        {
+            ArenaBlock * next = block->next;
+            free(block);
+            block = next;
+        }
+        arenaInit(arena, arena->blockSize);
+}
+
+void arenaPrintStats (Arena * arena, const char * name, FILE * fp)
+{
+        fprintf(fp, "%s: %ld allocations, %lu bytes used, "
+                "%lu bytes peak in %ld blocks\n", name, arena->numAllocs,
+                (unsigned long) arena->bytesUsed,
+                (unsigned long) arena->peakReserved, arena->numBlocks);
+}
+
+static ArenaBlock * newBlock(Arena * arena, size_t minSize)
+{
+        ArenaBlock * block;
+        size_t       capacity = arena->blockSize;
+
+        /* Oversized requests get a block of their own. */
+        if ( minSize > capacity )
+            capacity = minSize;
+
+        if ( (block = malloc(sizeof(ArenaBlock) + capacity)) == NULL )
+        {
+            printError("%s", ERROR);
+            return NULL;
+        }
+        block->capacity = capacity;
+        block->used = 0;
+        block->dedicated = minSize > arena->blockSize;
+
+        /* An oversized block is placed behind the current block so that
+         * the space left in the current block is not wasted.
+         */
+        if ( block->dedicated && arena->blocks != NULL )
+        {
+            block->next = arena->blocks->next;
+            arena->blocks->next = block;
+        }
+        else
+        {
+            block->next = arena->blocks;
+            arena->blocks = block;
+        }
+
+        arena->numBlocks++;
+        arena->bytesReserved += sizeof(ArenaBlock) + capacity;
+        if ( arena->bytesReserved > arena->peakReserved )
+            arena->peakReserved = arena->bytesReserved;
+        return block;
+}
@@ -0,0 +1,85 @@
+/*
+ * Arena: a bump-pointer memory allocator.
+ *
+ * An arena hands out memory from large blocks obtained with malloc.
+ * Individual allocations are never freed; instead, everything that was
+ * allocated from an arena is released at once by arenaFree.  This makes
+ * allocation very cheap (usually just advancing a pointer) and makes it
+ * impossible to leak individual allocations, as long as the arena
+ * itself is freed.
+ *
+ * The arena also keeps statistics about its use (number of
+ * allocations, bytes handed out, and bytes obtained from the system)
+ * that can be printed when tuning memory use.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _ARENA_H
+#define _ARENA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+/* THE DATA STRUCTURES */
+
+typedef struct ArenaBlock ArenaBlock;     /* defined in arena.c */
+
+typedef struct {
+        ArenaBlock * blocks;    /* blocks obtained so far, newest first */
+        size_t blockSize;       /* size of a normal (not oversized) block */
+        long   numAllocs;       /* number of successful allocations */
+        long   numBlocks;       /* number of blocks obtained */
+        size_t bytesUsed;       /* bytes handed out, including padding */
+        size_t bytesReserved;   /* bytes obtained from malloc */
+        size_t peakReserved;    /* most bytes obtained at any one time */
+} Arena;
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+
+
+/* THE FUNCTIONS */
+
+void arenaInit (Arena * arena, size_t blockSize);
+        /* Postcondition: arena is empty and will obtain memory in
+         *      blocks of blockSize bytes (ARENA_DEFAULT_BLOCK_SIZE if
+         *      blockSize is 0).
+         */
+
+void * arenaAlloc (Arena * arena, size_t size);
+        /* Returns a pointer to size bytes, suitably aligned for any
+         *      type, that remain valid until arenaFree is called;
+         *      NULL if memory allocation error.
+         */
+
+void * arenaRealloc (Arena * arena, void * memory, size_t oldSize,
+                     size_t newSize);
+        /* Precondition: memory is NULL or was returned by arenaAlloc or
+         *      arenaRealloc for oldSize bytes.
+         * Returns a pointer to newSize bytes whose first oldSize bytes
+         *      are those of memory (which may no longer be used); NULL
+         *      if memory allocation error.
+         *      An allocation larger than the arena's block size has a
+         *      block of its own, which is resized in place with realloc,
+         *      so growing a large array does not strand its old copy in
+         *      the arena, and shrinking it returns memory to the system.
+         *      Other memory is never shrunk.
+         */
+
+char * arenaStrdup (Arena * arena, const char * string);
+        /* Returns a copy of string allocated in the arena; NULL if
+         *      memory allocation error.
+         */
+
+void arenaFree (Arena * arena);
+        /* Postcondition: all memory allocated from arena has been
+         *      released and the arena is empty (but still usable).
+         *      Statistics are reset.
+         */
+
+void arenaPrintStats (Arena * arena, const char * name, FILE * fp);
+        /* Postcondition: the arena's allocation count, bytes used, and
+         *      peak bytes reserved have been printed to fp.
+         */
+
+#endif
@@ -0,0 +1,44 @@
+/*
+ * Assembly context: functions to create and tear down the memory used
+ * by one assembly run.  See asmContext.h for details.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include <sys/resource.h>
+
+void contextInit (AsmContext * context)
+{
+    arenaInit(&context->arena, ARENA_DEFAULT_BLOCK_SIZE);
+    tableInitInArena(&context->table, &context->arena);
+}
+
+void contextFree (AsmContext * context)
+{
+    tableFree(&context->table);
+    arenaFree(&context->arena);
+    tableInitInArena(&context->table, &context->arena);
+}
+
+void contextPrintStats (AsmContext * context, FILE * fp)
+{
+    fprintf(fp, "labels: %d (capacity %d)\n", context->table.nbrLabels,
+            context->table.capacity);
+    arenaPrintStats(&context->arena, "arena", fp);
+    fprintf(fp, "peak RSS: %ld KB\n", peakResidentKB());
+}
+
+long peakResidentKB (void)
+{
+    struct rusage usage;
+
+    /* ru_maxrss is in kilobytes on Linux (bytes on macOS). */
+    if ( getrusage(RUSAGE_SELF, &usage) != 0 )
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;
+#else
+    return usage.ru_maxrss;
+#endif
+}
@@ -0,0 +1,48 @@
+/*
+ * Assembly context: everything one assembly run allocates.
+ *
+ * An assembly context owns an arena, and all memory allocated on
+ * behalf of one assembly (label names, label table storage, and
+ * anything else that lives as long as the assembly) comes from that
+ * arena.  Calling contextFree releases all of it at once, so the
+ * assembler can be run repeatedly in a long-lived process without
+ * leaking memory.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _ASM_CONTEXT_H
+#define _ASM_CONTEXT_H
+
+#include <stdio.h>
+
+#include "arena.h"
+#include "LabelTableArrayList.h"
+
+typedef struct {
+        Arena arena;                    /* owns all memory below */
+        LabelTableArrayList table;      /* labels and their addresses */
+} AsmContext;
+
+void contextInit (AsmContext * context);
+        /* Postcondition: context has an empty arena and an empty label
+         *      table whose storage comes from that arena.
+         */
+
+void contextFree (AsmContext * context);
+        /* Postcondition: everything allocated for the assembly has been
+         *      released; the context is empty, as after contextInit.
+         */
+
+void contextPrintStats (AsmContext * context, FILE * fp);
+        /* Postcondition: memory statistics for the context, and the
+         *      peak resident set size of the process, have been printed
+         *      to fp.
+         */
+
+long peakResidentKB (void);
+        /* Returns the peak resident set size of the process so far, in
+         *      kilobytes (0 if it cannot be determined).
+         */
+
+#endif
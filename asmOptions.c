@@ -0,0 +1,478 @@
+/*
+ * The process_asm_options function parses the assembler-specific
+ * command-line options, all of which start with "--" (except -O).  It
+ * fills in the options structure and then "erases" the options it
+ * recognized from the argument list, so that the remaining arguments can
+ * be handed to process_arguments, which handles the optional filename and
+ * debugging choice.  It returns 1 if all options were valid, or prints an
+ * error message and returns 0 otherwise.
+ *
+ * Usage:
+ *      assembler [--stats] [--pipeline | --stream] [--output=FILE]
+ *                [--format=binary|raw|hex] [--threads=N] [--max-memory=SIZE]
+ *                [--cache-entries=N] [--line-addresses]
+ *                [--emit-symbols=FILE] [--list-symbols=FILE]
+ *                [--symbols=FILE] [--object=FILE] [filename] [0|1]
+ *      assembler --link [--output=FILE] [--format=binary|raw|hex]
+ *                [--threads=N] [--stats] object ...
+ *      assembler --disassemble [--format=binary|raw|hex] [--symbols=FILE]
+ *                [--output=FILE] [--stats] [filename] [0|1]
+ *      assembler --pipeline-model [--symbols=FILE] [filename] [0|1]
+ *      assembler --run [--memory-size=SIZE] [--max-steps=N]
+ *                [--register=REG=VALUE ...] [--symbols=FILE] [filename] [0|1]
+ *      assembler [--prune-unreachable] [--entry=LABEL] [--cfg-dot=FILE]
+ *                [-O] [--schedule [--insert-nops]] [--fill-delay-slots]
+ *                [--format=binary|raw|hex]
+ *                [--output=FILE] [--symbols=FILE] [--emit-symbols=FILE]
+ *                [--list-symbols=FILE] [filename] [0|1]
+ *      assembler --dcache [--dcache-size=SIZE] [--dcache-ways=N]
+ *                [--dcache-line=SIZE] [--dcache-replace=lru|fifo]
+ *                [--dcache-write=back|through] [--run options] [filename]
+ *
+ *   --stats    print statistics about the assembly (such as memory use)
+ *              to stderr when it is done
+ *   --pipeline run pass2 as a pipeline of reader, encoder, and writer
+ *              threads, so that I/O overlaps with encoding
+ *   --stream   do the work of pass1 and pass2 in a single pass, so that
+ *              output starts before the input ends (and the input may
+ *              be a pipe); forward label references wait until their
+ *              labels are defined
+ *   --output=FILE  write the output to FILE rather than stdout; a regular
+ *              file is sized up front, mapped into memory, and written
+ *              in place by several threads (unless --pipeline or
+ *              --stream is given)
+ *   --format=F write each instruction as pseudo-binary (binary, the
+ *              default), as 4 raw bytes (raw), or as 8 hex digits (hex)
+ *   --threads=N  number of threads to write an output file with
+ *              (default: one per processor)
+ *   --max-memory=SIZE  memory budget, in bytes or with a K, M, or G
+ *              suffix; the whole program is held in memory (and encoded
+ *              in parallel) only if it fits in the budget, and is
+ *              otherwise streamed from input to output; the peak
+ *              resident set size is reported to stderr
+ *   --cache-entries=N  number of entries in the cache of instructions
+ *              already encoded (default 512; 0 turns the cache off)
+ *   --line-addresses  give every line of the input 4 bytes, as the
+ *              assembler originally did, rather than only the lines that
+ *              hold instructions (blank, comment, and label-only lines
+ *              then take up space, and labels get their own line's
+ *              address)
+ *   --emit-symbols=FILE  save the label table, once the assembly is done,
+ *              as a symbol map that a later assembly can import
+ *   --list-symbols=FILE  write the label table to FILE as text, one
+ *              label per line, in order of address
+ *   --symbols=FILE  import the labels in the symbol map FILE (written by
+ *              --emit-symbols), so that instructions may refer to them
+ *              as though they were defined in the input
+ *   --object=FILE  assemble the input as a relocatable unit and write it
+ *              to the object file FILE, for --link; labels named in
+ *              .globl directives may be used by other units
+ *   --link     link the object files named by the other arguments into
+ *              one program, in the order given, using --threads threads
+ *   --disassemble  read words in the --format format, rather than source,
+ *              and print them as source; the labels in the --symbols
+ *              map name the addresses they are at
+ *   --pipeline-model  report the stalls, control penalties, and CPI the
+ *              program would have on a 5-stage pipeline, per basic block,
+ *              rather than printing it (see modelPipeline)
+ *   --run      run the program, rather than printing it, and print the
+ *              registers that are not 0 at the end, with the number of
+ *              instructions run per second (see run.h)
+ *   --memory-size=SIZE  bytes of data memory for --run, with an optional
+ *              K, M, or G suffix (default 1M)
+ *   --max-steps=N  stop --run after N instructions
+ *   --register=REG=VALUE  start --run with VALUE in register REG (e.g.,
+ *              --register=$a0=10); may be given for several registers
+ *   --dcache   run the program (as --run does) through a model of a data
+ *              cache, and report its hit rate, misses per 1000
+ *              instructions, and the source lines that miss most (see
+ *              dataCache.h)
+ *   --dcache-size=SIZE  bytes the cache holds, with an optional K or M
+ *              suffix (default 16K)
+ *   --dcache-ways=N  lines in each set (default 4; 1 is direct-mapped)
+ *   --dcache-line=SIZE  bytes in a line (default 32)
+ *   --dcache-replace=P  replace the least recently used line in a set
+ *              (lru, the default) or the first one filled (fifo)
+ *   --dcache-write=P  write-back with write-allocate (back, the default)
+ *              or write-through without write-allocate (through)
+ *   --fill-delay-slots  print the program for hardware with branch delay
+ *              slots: move an independent instruction from before each
+ *              branch and jump into the slot after it, or else put a
+ *              nop there, and report the slots filled to stderr (see
+ *              fillDelaySlots); labels move with their instructions
+ *   --prune-unreachable  remove the basic blocks that cannot be reached
+ *              from the entry, and report how many to stderr (see
+ *              removeUnreachable and cfg.c); labels move with their
+ *              instructions
+ *   --entry=LABEL  where the program starts, for --prune-unreachable and
+ *              --cfg-dot (default: its first instruction)
+ *   --cfg-dot=FILE  write the control-flow graph to FILE in the Graphviz
+ *              dot language, with unreachable blocks drawn dashed
+ *   -O         remove obvious waste from the program with a table of
+ *              peephole patterns (moves to self, jumps to the next
+ *              instruction, jumps to jumps), and report the rewrites and
+ *              instructions saved to stderr (see peephole); labels move
+ *              with their instructions, and no instruction a label or
+ *              branch refers to is deleted
+ *   --schedule  reorder the instructions in each basic block so that
+ *              loaded values are not used right after their loads, and
+ *              report the load-use stalls before and after to stderr (see
+ *              scheduleBlocks); the program is then printed, or run or
+ *              modeled if --run or --pipeline-model is given
+ *   --insert-nops  with --schedule, put a nop between a load and a use
+ *              right after it that could not be separated, for pipelines
+ *              without interlocks
+ */
+
+#include "assembler.h"
+#include "encodeCache.h"
+#include "run.h"
+
+/* Returns the number of bytes in a size such as "4096", "64K", "512M",
+ * or "2G"; 0 if it is not a valid size.
+ */
+static size_t parseSize(const char * size)
+{
+    char * end;
+    double value = strtod(size, &end);
+
+    if ( end == size || value <= 0 )
+        return 0;
+    switch ( toupper((unsigned char) *end) )
+    {
+        case 'G': value *= 1024;        /* fall through */
+        case 'M': value *= 1024;        /* fall through */
+        case 'K': value *= 1024;
+                  end++;
+                  break;
+    }
+    return *end == '\0' ? (size_t) value : 0;
+}
+
+/* Parses a count such as the number of ways of a cache or of threads.
+ * Returns it, or 0 if it is not a count from 1 to 1024 * 1024.
+ */
+static int parseCount(const char * count)
+{
+    char * end;
+    long   value = strtol(count, &end, 10);
+
+    if ( end == count || *end != '\0' || value < 1 || value > 1024 * 1024 )
+        return 0;
+    return (int) value;
+}
+
+/* Sets the starting value of a register from a setting such as
+ * "$a0=10" or "$t1=0x40".  Returns 1 if the setting is valid; 0 if not.
+ */
+static int parseRegister(const char * setting, AsmOptions * options)
+{
+    char   name[8];
+    char * end;
+    const char * equals = strchr(setting, '=');
+    long   value;
+    int    reg;
+
+    if ( equals == NULL || (size_t) (equals - setting) >= sizeof(name) )
+        return 0;
+    memcpy(name, setting, equals - setting);
+    name[equals - setting] = '\0';
+    value = strtol(equals + 1, &end, 0);
+    if ( (reg = registerNumber(name)) <= 0 || end == equals + 1 ||
+         *end != '\0' || value < -2147483648L || value > 4294967295L )
+        return 0;
+    options->registers[reg] = (unsigned int) value;
+    options->registersGiven |= 1U << reg;
+    return 1;
+}
+
+int process_asm_options(int * argc, char * argv[], AsmOptions * options)
+{
+    DataCacheConfig dcache;
+    int from, to, dcacheSettings = 0;
+
+    /* Default options. */
+    options->printStats = 0;
+    options->pipeline = 0;
+    options->stream = 0;
+    options->outputName = NULL;
+    options->format = FORMAT_BINARY;
+    options->numThreads = 0;
+    options->maxMemory = 0;
+    options->cacheEntries = CACHE_DEFAULT_ENTRIES;
+    options->lineAddresses = 0;
+    options->emitSymbols = NULL;
+    options->listSymbols = NULL;
+    options->symbols = NULL;
+    options->objectName = NULL;
+    options->link = 0;
+    options->disassemble = 0;
+    options->run = 0;
+    options->pipelineModel = 0;
+    options->memorySize = RUN_DEFAULT_MEMORY;
+    options->maxSteps = 0;
+    memset(options->registers, 0, sizeof(options->registers));
+    options->registersGiven = 0;
+    dataCacheDefaults(&dcache);
+    options->dataCache = 0;
+    options->dcacheSize = dcache.size;
+    options->dcacheWays = dcache.ways;
+    options->dcacheLine = dcache.lineSize;
+    options->dcacheFifo = dcache.replacement == DCACHE_FIFO;
+    options->dcacheWriteThrough = dcache.writeThrough;
+    options->fillDelaySlots = 0;
+    options->pruneUnreachable = 0;
+    options->entry = NULL;
+    options->cfgDot = NULL;
+    options->optimize = 0;
+    options->schedule = 0;
+    options->insertNops = 0;
+
+    /* Copy each argument that is not an option down into the next
+     * unused slot, so that only non-option arguments remain.
+     */
+    for ( from = 1, to = 1; from < *argc; from++ )
+    {
+        char * arg = argv[from];
+
+        if ( strcmp(arg, "-O") == SAME )
+            options->optimize = 1;
+        else if ( strncmp(arg, "--", 2) != SAME )
+            argv[to++] = arg;
+        else if ( strcmp(arg, "--stats") == SAME )
+            options->printStats = 1;
+        else if ( strcmp(arg, "--pipeline") == SAME )
+            options->pipeline = 1;
+        else if ( strcmp(arg, "--stream") == SAME )
+            options->stream = 1;
+        else if ( strcmp(arg, "--line-addresses") == SAME )
+            options->lineAddresses = 1;
+        else if ( strncmp(arg, "--output=", 9) == SAME && arg[9] != '\0' )
+            options->outputName = arg + 9;
+        else if ( strncmp(arg, "--emit-symbols=", 15) == SAME &&
+                  arg[15] != '\0' )
+            options->emitSymbols = arg + 15;
+        else if ( strncmp(arg, "--list-symbols=", 15) == SAME &&
+                  arg[15] != '\0' )
+            options->listSymbols = arg + 15;
+        else if ( strncmp(arg, "--symbols=", 10) == SAME && arg[10] != '\0' )
+            options->symbols = arg + 10;
+        else if ( strncmp(arg, "--object=", 9) == SAME && arg[9] != '\0' )
+            options->objectName = arg + 9;
+        else if ( strcmp(arg, "--link") == SAME )
+            options->link = 1;
+        else if ( strcmp(arg, "--disassemble") == SAME )
+            options->disassemble = 1;
+        else if ( strcmp(arg, "--run") == SAME )
+            options->run = 1;
+        else if ( strcmp(arg, "--pipeline-model") == SAME )
+            options->pipelineModel = 1;
+        else if ( strcmp(arg, "--fill-delay-slots") == SAME )
+            options->fillDelaySlots = 1;
+        else if ( strcmp(arg, "--prune-unreachable") == SAME )
+            options->pruneUnreachable = 1;
+        else if ( strncmp(arg, "--entry=", 8) == SAME && arg[8] != '\0' )
+            options->entry = arg + 8;
+        else if ( strncmp(arg, "--cfg-dot=", 10) == SAME && arg[10] != '\0' )
+            options->cfgDot = arg + 10;
+        else if ( strcmp(arg, "--schedule") == SAME )
+            options->schedule = 1;
+        else if ( strcmp(arg, "--insert-nops") == SAME )
+            options->insertNops = 1;
+        else if ( strcmp(arg, "--dcache") == SAME )
+            options->dataCache = options->run = 1;
+        else if ( strcmp(arg, "--dcache-replace=lru") == SAME ||
+                  strcmp(arg, "--dcache-replace=fifo") == SAME )
+        {
+            options->dcacheFifo = arg[17] == 'f';
+            dcacheSettings++;
+        }
+        else if ( strcmp(arg, "--dcache-write=back") == SAME ||
+                  strcmp(arg, "--dcache-write=through") == SAME )
+        {
+            options->dcacheWriteThrough = arg[15] == 't';
+            dcacheSettings++;
+        }
+        else if ( strncmp(arg, "--dcache-size=", 14) == SAME )
+        {
+            if ( (options->dcacheSize = parseSize(arg + 14)) == 0 )
+            {
+                printError("Error: invalid cache size %s.\n", arg + 14);
+                return 0;
+            }
+            dcacheSettings++;
+        }
+        else if ( strncmp(arg, "--dcache-ways=", 14) == SAME )
+        {
+            if ( (options->dcacheWays = parseCount(arg + 14)) == 0 )
+            {
+                printError("Error: invalid number of ways %s.\n", arg + 14);
+                return 0;
+            }
+            dcacheSettings++;
+        }
+        else if ( strncmp(arg, "--dcache-line=", 14) == SAME )
+        {
+            size_t line = parseSize(arg + 14);
+
+            if ( line == 0 || line > 1024 * 1024 )
+            {
+                printError("Error: invalid cache line size %s.\n", arg + 14);
+                return 0;
+            }
+            options->dcacheLine = (int) line;
+            dcacheSettings++;
+        }
+        else if ( strncmp(arg, "--format=", 9) == SAME )
+        {
+            if ( (options->format = findOutputFormat(arg + 9)) == -1 )
+            {
+                printError("Error: unknown output format %s.\n", arg + 9);
+                return 0;
+            }
+        }
+        else if ( strncmp(arg, "--max-memory=", 13) == SAME )
+        {
+            if ( (options->maxMemory = parseSize(arg + 13)) == 0 )
+            {
+                printError("Error: invalid memory size %s.\n", arg + 13);
+                return 0;
+            }
+        }
+        else if ( strncmp(arg, "--cache-entries=", 16) == SAME )
+        {
+            char * end;
+            long   entries = strtol(arg + 16, &end, 10);
+
+            if ( end == arg + 16 || *end != '\0' || entries < 0 ||
+                 entries > 1024 * 1024 )
+            {
+                printError("Error: invalid number of cache entries %s.\n",
+                           arg + 16);
+                return 0;
+            }
+            options->cacheEntries = (int) entries;
+        }
+        else if ( strncmp(arg, "--memory-size=", 14) == SAME )
+        {
+            if ( (options->memorySize = parseSize(arg + 14)) < 4 )
+            {
+                printError("Error: invalid memory size %s.\n", arg + 14);
+                return 0;
+            }
+        }
+        else if ( strncmp(arg, "--max-steps=", 12) == SAME )
+        {
+            char * end;
+
+            options->maxSteps = strtol(arg + 12, &end, 10);
+            if ( end == arg + 12 || *end != '\0' || options->maxSteps < 1 )
+            {
+                printError("Error: invalid number of steps %s.\n", arg + 12);
+                return 0;
+            }
+        }
+        else if ( strncmp(arg, "--register=", 11) == SAME )
+        {
+            if ( ! parseRegister(arg + 11, options) )
+            {
+                printError("Error: invalid register value %s.\n", arg + 11);
+                return 0;
+            }
+        }
+        else if ( strncmp(arg, "--threads=", 10) == SAME )
+        {
+            if ( (options->numThreads = parseCount(arg + 10)) < 1 )
+            {
+                printError("Error: invalid number of threads %s.\n",
+                           arg + 10);
+                return 0;
+            }
+        }
+        else
+        {
+            printError("Error: unknown option %s.\n", arg);
+            return 0;
+        }
+    }
+    if ( options->pipeline && options->stream )
+    {
+        printError("Error: --pipeline and --stream cannot be combined.\n");
+        return 0;
+    }
+    if ( options->objectName != NULL &&
+         (options->pipeline || options->stream || options->link ||
+          options->outputName != NULL || options->lineAddresses ||
+          options->symbols != NULL) )
+    {
+        printError("Error: --object cannot be combined with --pipeline, "
+                   "--stream, --link, --output, --line-addresses, or "
+                   "--symbols.\n");
+        return 0;
+    }
+    if ( options->disassemble &&
+         (options->pipeline || options->stream || options->link ||
+          options->objectName != NULL || options->lineAddresses ||
+          options->emitSymbols != NULL || options->listSymbols != NULL) )
+    {
+        printError("Error: --disassemble cannot be combined with "
+                   "--pipeline, --stream, --link, --object, "
+                   "--line-addresses, --emit-symbols, or --list-symbols.\n");
+        return 0;
+    }
+    if ( dcacheSettings > 0 && ! options->dataCache )
+    {
+        printError("Error: the --dcache- options need --dcache.\n");
+        return 0;
+    }
+    if ( options->run + options->pipelineModel > 1 )
+    {
+        printError("Error: --run and --pipeline-model cannot be "
+                   "combined.\n");
+        return 0;
+    }
+    if ( (options->run || options->pipelineModel) &&
+         (options->pipeline || options->stream || options->link ||
+          options->objectName != NULL || options->disassemble ||
+          options->outputName != NULL || options->lineAddresses) )
+    {
+        printError("Error: --run and --pipeline-model cannot be combined "
+                   "with --pipeline, --stream, --link, --object, "
+                   "--disassemble, --output, or --line-addresses.\n");
+        return 0;
+    }
+    if ( options->entry != NULL && ! options->pruneUnreachable &&
+         options->cfgDot == NULL )
+    {
+        printError("Error: --entry needs --prune-unreachable or "
+                   "--cfg-dot.\n");
+        return 0;
+    }
+    if ( options->insertNops && ! options->schedule )
+    {
+        printError("Error: --insert-nops needs --schedule.\n");
+        return 0;
+    }
+    if ( options->fillDelaySlots && (options->run || options->pipelineModel) )
+    {
+        printError("Error: --fill-delay-slots cannot be combined with "
+                   "--run, --pipeline-model, or --dcache.\n");
+        return 0;
+    }
+    if ( (options->pruneUnreachable || options->cfgDot != NULL ||
+          options->optimize || options->schedule ||
+          options->fillDelaySlots) &&
+         (options->pipeline || options->stream || options->link ||
+          options->objectName != NULL || options->disassemble ||
+          options->lineAddresses) )
+    {
+        printError("Error: --prune-unreachable, --cfg-dot, -O, --schedule, "
+                   "and --fill-delay-slots cannot be combined with "
+                   "--pipeline, --stream, --link, --object, "
+                   "--disassemble, or --line-addresses.\n");
+        return 0;
+    }
+    *argc = to;
+    argv[to] = NULL;
+    return 1;
+}
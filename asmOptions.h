@@ -0,0 +1,76 @@
+/*
+ * This file provides the data structure holding the assembler's
+ * command-line options and the signature of the function that
+ * processes them.
+ */
+
+#ifndef _ASM_OPTIONS_H
+#define _ASM_OPTIONS_H
+
+typedef struct {
+        int printStats;         /* --stats: print statistics to stderr */
+        int pipeline;           /* --pipeline: run pass2 as a pipeline of
+                                   reader, encoder, and writer threads */
+        int stream;             /* --stream: do pass1 and pass2 together
+                                   in one pass over the input */
+        const char * outputName; /* --output=FILE: write output to FILE
+                                   (NULL for stdout) */
+        int format;             /* --format=binary|raw|hex */
+        int numThreads;         /* --threads=N: threads to write an output
+                                   file with (0 for one per processor) */
+        size_t maxMemory;       /* --max-memory=SIZE: memory budget in
+                                   bytes (0 for no budget) */
+        int cacheEntries;       /* --cache-entries=N: entries in each
+                                   encode cache (0 for no cache) */
+        int lineAddresses;      /* --line-addresses: every line takes up
+                                   4 bytes, not just instructions */
+        const char * emitSymbols;  /* --emit-symbols=FILE: save the labels
+                                   as a symbol map (NULL: don't) */
+        const char * listSymbols;  /* --list-symbols=FILE: write the labels
+                                   as text, by address (NULL: don't) */
+        const char * symbols;   /* --symbols=FILE: import the labels in a
+                                   symbol map (NULL: none) */
+        const char * objectName;   /* --object=FILE: write a relocatable
+                                   object file (NULL: don't) */
+        int link;               /* --link: link the object files named
+                                   by the remaining arguments */
+        int disassemble;        /* --disassemble: print the words in the
+                                   input as source */
+        int run;                /* --run: run the program */
+        int pipelineModel;      /* --pipeline-model: report the program's
+                                   estimated stalls and CPI */
+        size_t memorySize;      /* --memory-size=SIZE: bytes of data
+                                   memory for --run */
+        long maxSteps;          /* --max-steps=N: instructions --run runs
+                                   at most (0 for no limit) */
+        unsigned int registers[32];     /* --register=REG=VALUE: starting
+                                   register values for --run */
+        unsigned int registersGiven;    /* bit r set if registers[r] was
+                                   given */
+        int dataCache;          /* --dcache: run the program through a
+                                   model of a data cache */
+        size_t dcacheSize;      /* --dcache-size=SIZE: bytes it holds */
+        int dcacheWays;         /* --dcache-ways=N: lines in each set */
+        int dcacheLine;         /* --dcache-line=SIZE: bytes in a line */
+        int dcacheFifo;         /* --dcache-replace=fifo (rather than
+                                   lru) */
+        int dcacheWriteThrough; /* --dcache-write=through (rather than
+                                   back) */
+        int fillDelaySlots;     /* --fill-delay-slots: fill the slot
+                                   after each branch and jump */
+        int pruneUnreachable;   /* --prune-unreachable: remove blocks
+                                   not reachable from the entry */
+        const char * entry;     /* --entry=LABEL: where the program
+                                   starts (NULL: its first instruction) */
+        const char * cfgDot;    /* --cfg-dot=FILE: draw the control-flow
+                                   graph with Graphviz (NULL: don't) */
+        int optimize;           /* -O: apply the peephole patterns */
+        int schedule;           /* --schedule: reorder each basic block
+                                   to avoid load-use stalls */
+        int insertNops;         /* --insert-nops: separate loads from
+                                   their uses with nops */
+} AsmOptions;
+
+int process_asm_options(int * argc, char * argv[], AsmOptions * options);
+
+#endif
@@ -16,7 +16,7 @@
  *                bne $t0, $zero, A_LABEL  # This instr. is at address 8
  *
  * USAGE:
- *          name [ filename ] [ 0|1 ]
+ *          name [ options ] [ filename ] [ 0|1 ]
  *      where "name" is the name of the executable, "filename" is an
  *      optional file containing the input to read, and " 0" or "1"
  *      specifies that debugging should be turned off or on, respectively,
@@ -25,7 +25,8 @@
  *      may appear in either order.  If no filename is provided, the
  *      program reads its input from stdin.  If no debugging choice is
  *      provided, the program prints debugging messages, or not, depending
- *      on indications in the code.
+ *      on indications in the code.  The options are described in
+ *      asmOptions.c.
  *
  * INPUT:
  *      This program expects the input to consist of lines of MIPS
@@ -57,18 +58,126 @@
  *      Improve function documentation.
  * Modified by:  Alyce Brady, 6/2/2019
  *      Improve function documentation.
+ * Modified: 10/19/2026
+ *      Keep all memory for the assembly in an assembly context that is
+ *      freed in one call.
+ *      Add command-line options (see asmOptions.c).
  */
 
 #include "assembler.h"
+#include "program.h"
+#include "encodeCache.h"
+#include "symbolMap.h"
+#include "objectFile.h"
+#include "run.h"
+#include "transform.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Returns the size of the input file, or 0 if it is not a regular file. */
+static size_t inputBytes(FILE * fp)
+{
+    struct stat info;
+
+    if ( fstat(fileno(fp), &info) == 0 && S_ISREG(info.st_mode) )
+        return (size_t) info.st_size;
+    return 0;
+}
+
+/* Returns 1 if the program is to be transformed (see transform.h). */
+static int transforming(const AsmOptions * options)
+{
+    return options->pruneUnreachable || options->cfgDot != NULL ||
+           options->optimize || options->schedule || options->fillDelaySlots;
+}
+
+/* Applies the transformations asked for to the program in image, whose
+ * labels are in table, reporting what they did to stderr.  Returns 1 if
+ * everything went OK; 0 if not (an error message has been printed).
+ */
+static int transformProgram(Image * image, LabelTableArrayList * table,
+                            const AsmOptions * options)
+{
+    Code   code;
+    long   entry = 0;           /* where the program starts */
+    FILE * dot;
+    int    ok = 1;
+
+    if ( ! transforming(options) )
+        return 1;
+    if ( options->entry != NULL )
+    {
+        int index = findLabelIndex(table, options->entry);
+
+        if ( index == -1 )
+        {
+            printError("Error: the entry label %s is not defined.\n",
+                       options->entry);
+            return 0;
+        }
+        entry = table->addresses[index];
+    }
+    if ( ! codeFromImage(&code, image, table) )
+        return 0;
+
+    if ( options->cfgDot != NULL )
+    {
+        if ( (dot = fopen(options->cfgDot, "w")) == NULL )
+        {
+            printError("Error: cannot open output file %s.\n",
+                       options->cfgDot);
+            ok = 0;
+        }
+        else
+        {
+            ok = writeCfg(&code, table, entry, dot);
+            fclose(dot);
+        }
+    }
+    ok = ok &&
+         (! options->pruneUnreachable ||
+          removeUnreachable(&code, entry, stderr) >= 0) &&
+         (! options->optimize || peephole(&code, stderr) >= 0) &&
+         (! options->schedule ||
+          scheduleBlocks(&code, options->insertNops, stderr) >= 0) &&
+         (! options->fillDelaySlots || fillDelaySlots(&code, stderr) >= 0) &&
+         codeToImage(&code, image, table);
+    codeFree(&code);
+    return ok;
+}
 
 int main (int argc, char * argv[])
 {
     FILE * fptr;               /* file pointer */
-    LabelTableArrayList table;
+    AsmContext context;        /* owns the label table and its memory */
+    AsmOptions options;
+    SymbolMap symbols;         /* imported labels, if any */
+    int outputFd = -1;         /* output file to write in place, if any */
+    int numLines;              /* number of lines of input */
+    int inMemory;              /* hold the whole program in memory? */
 
-    /* Process command-line arguments (if any) -- input file name
-     *    and/or debugging indicator (1 = on; 0 = off).
+    /* Process command-line arguments (if any) -- assembler options,
+     *    input file name and/or debugging indicator (1 = on; 0 = off).
      */
+    if ( ! process_asm_options(&argc, argv, &options) )
+    {
+        return 1;   /* Fatal error when processing options */
+    }
+
+    /* Link object files, rather than assembling a source file. */
+    if ( options.link )
+    {
+        setOutputFormat (options.format);
+        if ( options.outputName != NULL &&
+             openOutputFile (options.outputName, 0) == -2 )
+            return 1;   /* Fatal error when opening output file */
+        if ( ! linkObjects (argc - 1, argv + 1, options.numThreads,
+                            options.printStats) )
+            return 1;
+        fflush (stdout);
+        return 0;
+    }
+
     fptr = process_arguments(argc, argv);
     if ( fptr == NULL )
     {
@@ -85,20 +194,188 @@ int main (int argc, char * argv[])
                 "Type control-D to end input from keyboard.\n");
     }
 
-    /* Call pass1 to generate the label table. */
-    table = pass1 (fptr);
+    /* Open the output file, if there is one.  Unless the output will be
+     * written through stdout anyway, a regular file is written in place
+     * by pass2Mapped.
+     */
+    setOutputFormat (options.format);
+    setCacheSize (options.cacheEntries);
+    setLineAddresses (options.lineAddresses);
+    if ( options.outputName != NULL )
+    {
+        outputFd = openOutputFile (options.outputName,
+                                   ! options.stream && ! options.pipeline &&
+                                   ! options.disassemble &&
+                                   ! transforming(&options));
+        if ( outputFd == -2 )
+            return 1;   /* Fatal error when opening output file */
+    }
+
+    contextInit (&context);
+
+    /* Import the labels of an earlier assembly, if asked to. */
+    if ( options.symbols != NULL )
+    {
+        if ( ! symbolMapOpen (&symbols, options.symbols) )
+        {
+            contextFree (&context);
+            return 1;   /* Fatal error when opening the symbol map */
+        }
+        context.table.imported = &symbols.table;
+    }
 
-    /* Print the label table if debugging is turned on. */
-    if ( debug_is_on() )
-        printLabels (&table);
+    /* Print words as source, rather than source as words. */
+    if ( options.disassemble )
+        disassemble (fptr, options.symbols != NULL ? &symbols.table : NULL,
+                     options.format, options.printStats ? stderr : NULL);
 
-    /* rewind the file pointer to be back at the beginning of the file 
-     * and then call pass2, passing it the label table.
-     **/
-    rewind (fptr);
-    pass2(fptr, &table);
+    /* In streaming mode, labels are found and instructions encoded in
+     * the same pass.
+     */
+    else if ( options.stream )
+    {
+        streamPass (fptr, &context.table,
+                    options.printStats ? stderr : NULL);
+        if ( debug_is_on() )
+            printLabels (&context.table);
+    }
+    else if ( options.run || options.pipelineModel || transforming(&options) )
+    {
+        /* Run or model the program, or transform it before printing
+         * it.
+         */
+        RunConfig       config;
+        Image           image;
+        DataCacheConfig dcache;
+        DataCache       dataCache;
+
+        pass1IntoTable (fptr, &context.table);
+        rewind (fptr);
+        runConfigInit (&config);
+        config.memorySize = options.memorySize;
+        config.maxSteps = options.maxSteps;
+        memcpy (config.registers, options.registers, sizeof(config.registers));
+        config.registersGiven = options.registersGiven;
+        dcache.size = options.dcacheSize;
+        dcache.ways = options.dcacheWays;
+        dcache.lineSize = options.dcacheLine;
+        dcache.replacement = options.dcacheFifo ? DCACHE_FIFO : DCACHE_LRU;
+        dcache.writeThrough = options.dcacheWriteThrough;
+        if ( imageAssemble (&image, fptr, &context.table) &&
+             transformProgram (&image, &context.table, &options) )
+        {
+            if ( options.pipelineModel )
+                modelPipeline (&image, &context.table, stdout);
+            else if ( ! options.run )
+                imageWrite (&image);
+            else if ( ! options.dataCache )
+                runProgram (&image, &config, stderr);
+            else if ( dataCacheInit (&dataCache, &dcache, image.numWords) )
+            {
+                config.dataCache = &dataCache;
+                runProgram (&image, &config, stderr);
+                dataCacheFree (&dataCache);
+            }
+        }
+        imageFree (&image);
+        if ( debug_is_on() )
+            printLabels (&context.table);
+    }
+    else if ( options.objectName != NULL )
+    {
+        /* Write a relocatable unit, rather than the program. */
+        pass1IntoTable (fptr, &context.table);
+        if ( debug_is_on() )
+            printLabels (&context.table);
+        rewind (fptr);
+        objectPass (fptr, &context.table, options.objectName);
+    }
+    else
+    {
+        /* Call pass1 to generate the label table. */
+        numLines = pass1IntoTable (fptr, &context.table);
+
+        /* Print the label table if debugging is turned on. */
+        if ( debug_is_on() )
+            printLabels (&context.table);
+
+        /* Hold the whole program in memory if the output is written in
+         * place, or if it fits in the memory budget; otherwise stream
+         * the input to the output through fixed-size buffers.
+         */
+        inMemory = outputFd != -1;
+        if ( options.maxMemory > 0 && ! options.pipeline )
+        {
+            size_t needed;
+
+            tableCompact (&context.table);
+            needed = tableBytes(&context.table) +
+                     programEstimate(inputBytes(fptr), numLines);
+            if ( outputFd != -1 )
+                needed += (size_t) numLines * outputWordLength();
+            inMemory = needed <= options.maxMemory;
+            fprintf (stderr, "memory: in-memory assembly needs about %lu KB "
+                     "of %lu KB; %s\n", (unsigned long) (needed / 1024),
+                     (unsigned long) (options.maxMemory / 1024),
+                     inMemory ? "holding the program in memory"
+                              : "streaming");
+        }
+        if ( ! inMemory && outputFd != -1 )
+        {
+            /* Stream to the output file through stdout. */
+            fflush (stdout);
+            dup2 (outputFd, STDOUT_FILENO);
+            close (outputFd);
+            outputFd = -1;
+        }
+
+        /* rewind the file pointer to be back at the beginning of the
+         * file and then call pass2, passing it the label table.
+         **/
+        rewind (fptr);
+        if ( inMemory )
+        {
+            if ( ! pass2Mapped(fptr, &context.table, outputFd,
+                               options.numThreads) )
+            {
+                /* Could not hold the input in memory; write in order. */
+                if ( outputFd != -1 )
+                {
+                    fflush (stdout);
+                    dup2 (outputFd, STDOUT_FILENO);
+                    close (outputFd);
+                }
+                rewind (fptr);
+                pass2(fptr, &context.table);
+            }
+        }
+        else if ( ! options.pipeline ||
+                  ! pass2Pipelined(fptr, &context.table) )
+            pass2(fptr, &context.table);
+    }
+
+    fflush (stdout);
+    if ( options.maxMemory > 0 )
+        fprintf (stderr, "peak RSS: %ld KB (budget %lu KB)\n",
+                 peakResidentKB(),
+                 (unsigned long) (options.maxMemory / 1024));
+
+    if ( options.printStats )
+    {
+        contextPrintStats (&context, stderr);
+        cachePrintStats (stderr);
+    }
 
+    /* Save the label table, if asked to. */
+    if ( options.emitSymbols != NULL )
+        symbolMapWrite (&context.table, options.emitSymbols);
+    if ( options.listSymbols != NULL )
+        symbolMapWriteText (&context.table, options.listSymbols);
 
+    /* Release everything the assembly allocated in one call. */
+    contextFree (&context);
+    if ( options.symbols != NULL )
+        symbolMapClose (&symbols);
     (void) fclose(fptr);
     return 0;
 }
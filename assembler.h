@@ -12,25 +12,97 @@
 #include <string.h>	/* Might be memory.h on some machines. */
 #include <ctype.h>
 
+#include "arena.h"
 #include "LabelTableArrayList.h"
+#include "asmContext.h"
+#include "asmOptions.h"
 #include "getToken.h"
+#include "instrTable.h"
+#include "packFields.h"
 #include "printFuncs.h"
 #include "process_arguments.h"
 #include "same.h"
 
+/* Results of encoding one line of assembly source (see assembleLine). */
+#define ASM_ERROR  -1           /* invalid instruction; error printed */
+#define ASM_NONE    0           /* no instruction on the line */
+#define ASM_OK      1           /* instruction encoded */
+#define ASM_CACHED  2           /* instruction found in an encode cache */
+
+/* Output formats, and the length of one instruction in each. */
+#define FORMAT_BINARY  0        /* pseudo-binary '0's and '1's */
+#define FORMAT_RAW     1        /* 4 bytes, most significant first */
+#define FORMAT_HEX     2        /* 8 hexadecimal digits */
+#define BINARY_WORD_LENGTH 33   /* 32 characters and a newline */
+#define RAW_WORD_LENGTH     4
+#define HEX_WORD_LENGTH     9   /* 8 characters and a newline */
+#define MAX_WORD_LENGTH    BINARY_WORD_LENGTH
+
+/* Kinds of reference from an instruction to a label (see LabelRef). */
+#define REF_NONE    0           /* no unresolved reference */
+#define REF_BRANCH  1           /* 16-bit branch offset, relative to PC */
+#define REF_JUMP    2           /* 26-bit jump target */
+
+/* A reference from an instruction to a label that was not yet defined
+ * when the instruction was encoded.  The label's field of the word is
+ * left as 0 until the label is defined (see patchLabelRef).
+ */
+typedef struct {
+        int    kind;            /* REF_NONE, REF_BRANCH, or REF_JUMP */
+        char * label;           /* the label (points into the line) */
+        int    PC;              /* address of the following instruction */
+        int    lineNum;         /* line number (for error messages) */
+} LabelRef;
+
+/* Kinds of operand token (see parseOperand). */
+#define OPERAND_REGISTER 0      /* e.g., $t0 or $8 */
+#define OPERAND_NUMBER   1      /* e.g., 23, -4, or 0x1F */
+#define OPERAND_LABEL    2      /* e.g., loop */
+
+/* One operand token of an instruction, classified and parsed. */
+typedef struct {
+        int    kind;            /* OPERAND_REGISTER, _NUMBER, or _LABEL */
+        long   value;           /* register number or number (0 for a
+                                   label) */
+        char * text;            /* the token */
+} Operand;
+
 LabelTableArrayList pass1 (FILE * fp);
+int  pass1IntoTable (FILE * fp, LabelTableArrayList * table);
+char * getLabel(char * input);
+void setLineAddresses(int on);
+int  usesLineAddresses(void);
+int  instructionSize(const char * line, size_t length);
+int  addressStep(int result);
 void pass2 (FILE * fp, LabelTableArrayList * table);
+int  pass2Pipelined (FILE * fp, LabelTableArrayList * table);
+void streamPass (FILE * fp, LabelTableArrayList * table, FILE * statsFp);
+int  openOutputFile (const char * name, int inPlace);
+int  pass2Mapped (FILE * fp, LabelTableArrayList * table, int fd,
+                  int numThreads);
+long disassemble (FILE * fp, LabelTableArrayList * labels, int format,
+                  FILE * statsFp);
+
+int assembleLine(char * inst, int lineNum, int PC,
+                 LabelTableArrayList * table, unsigned int * word,
+                 LabelRef * unresolved);
+int decodeLine(char * inst, int lineNum, int PC,
+               LabelTableArrayList * table, InstrFields * fields,
+               LabelRef * unresolved);
+int patchLabelRef(unsigned int * word, const LabelRef * ref, int address);
 
 int getNTokens (char * instructionBuffer, int N, char * results[]);
+int parseOperand(char * token, Operand * operand);
+int registerNumber(const char * name);
 
 void getInstName(char * input, char ** instrName, char **restOfLine);
 
 int getOpCode(char * instrName);
 int getFunctCode(char * instrName);
 
-void processIorJ(int lineNum, LabelTableArrayList * table,
-                 int opcode, char * restOfInstruction, int PC);
-void processR(int lineNum, int functCode, char * restOfInstruction);
+int processOperands(int lineNum, LabelTableArrayList * table,
+                    const InstrTemplate * template, char * restOfInstruction,
+                    int PC, InstrFields * fields, LabelRef * unresolved);
 
 void printInt(int value, int length);
 void printReg(char * regName, int lineNum);
@@ -40,4 +112,14 @@ void printJumpTarget(char * targetLabel, LabelTableArrayList * table,
 void printBranchOffset(char * targetLabel, LabelTableArrayList * table,
                        int PC, int lineNum);
 
+int getJumpTarget(char * targetLabel, LabelTableArrayList * table,
+                  int lineNum, int * target);
+int getBranchOffset(char * targetLabel, LabelTableArrayList * table,
+                    int PC, int lineNum, int * offset);
+void formatBinaryWord(unsigned int word, char * buffer);
+void setOutputFormat(int format);
+int  findOutputFormat(const char * name);
+int  outputWordLength(void);
+int  formatWord(unsigned int word, char * buffer);
+
 #endif
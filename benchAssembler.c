@@ -0,0 +1,438 @@
+/*
+ * benchAssembler: times the assembler over a matrix of synthetic programs.
+ *
+ * For every combination of program size, label density, branch
+ * distance, and instruction mix, this driver runs genMips to create a
+ * program (in the corpus directory, generated afresh on every run so
+ * that it always matches the current generator), then runs the
+ * assembler on each program in turn, several times over, with its
+ * output discarded.  It reports the median wall-clock and CPU (user plus
+ * system) times of the repetitions along with lines/sec, ns/instruction,
+ * and the peak resident memory of the assembler process.
+ *
+ * USAGE:
+ *          benchAssembler [-n sizes] [-l densities] [-b distances]
+ *                         [-m mixes] [-r repeats] [-s seed]
+ *                         [-a assembler] [-g generator] [-d corpusDir]
+ *      where sizes, densities, distances, and mixes are comma-separated
+ *      lists, e.g., -n 1000,1000000,10000000 -m alu,control.
+ *      Defaults: -n 1000,10000,100000 -l 0.02,0.2 -b 16,4096 -m mixed
+ *                -r 3 -s 1 -a ./assembler -g ./genMips -d bench_corpus
+ *
+ * PERFORMANCE BASELINES:
+ *          benchAssembler ... -w baselineFile
+ *      writes the throughput (lines per CPU second, which other load on
+ *      the machine disturbs much less than wall-clock time) and peak
+ *      memory of every benchmark to baselineFile, one benchmark per
+ *      line.
+ *          benchAssembler ... -c baselineFile [-t thresholdPercent]
+ *      compares each benchmark against the baseline, prints a table of
+ *      the changes, and exits with status 1 if any benchmark's
+ *      throughput dropped, or its peak memory grew, by more than the
+ *      threshold (default 10 percent).  Benchmarks that are not in the
+ *      baseline, or whose median time is under MIN_CHECKED_SECONDS (so
+ *      that process startup, not assembly, dominates it), are reported
+ *      but never fail the check.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "same.h"
+
+#define MAX_LIST 16
+#define MAX_BENCHMARKS 1024
+#define MIN_CHECKED_SECONDS 0.1
+
+/* A comma-separated list of values from the command line. */
+typedef struct {
+        int    count;
+        char * items[MAX_LIST];
+} ValueList;
+
+/* The outcome of timing one program. */
+typedef struct {
+        char   name[256];       /* name of the benchmark */
+        char   source[512];     /* the program */
+        long   lines;           /* lines in the program */
+        long   instructions;    /* lines that contain an instruction */
+        double seconds;         /* median wall-clock time */
+        double cpuSeconds;      /* median CPU time */
+        long   maxRssKB;        /* largest peak resident set size seen */
+} BenchResult;
+
+static void splitList(char * text, ValueList * list)
+{
+    char * item;
+
+    list->count = 0;
+    for ( item = strtok(text, ","); item != NULL && list->count < MAX_LIST;
+          item = strtok(NULL, ",") )
+        list->items[list->count++] = item;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Runs argv[0] with stdout redirected to `outPath` and stderr discarded.
+ * Returns the exit status (or -1 if the program could not be run) and
+ * fills in the elapsed and CPU times and peak memory.
+ */
+static int runProgram(char * argv[], const char * outPath,
+                      double * seconds, double * cpuSeconds, long * maxRssKB)
+{
+    struct rusage usage;
+    double start = now();
+    int    status;
+    pid_t  pid;
+
+    if ( (pid = fork()) < 0 )
+        return -1;
+    if ( pid == 0 )
+    {
+        int out = open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+        if ( out < 0 || err < 0 )
+            _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if ( wait4(pid, &status, 0, &usage) < 0 )
+        return -1;
+
+    *seconds = now() - start;
+    *cpuSeconds = usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+                  usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+    *maxRssKB = usage.ru_maxrss;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+static int compareSeconds(const void * a, const void * b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+
+    return x < y ? -1 : x > y;
+}
+
+/* Sorts the n times and returns their median. */
+static double median(double times[], int n)
+{
+    qsort(times, n, sizeof(double), compareSeconds);
+    return n % 2 == 1 ? times[n / 2] : (times[n / 2 - 1] + times[n / 2]) / 2;
+}
+
+/* Counts the lines in the program, and the lines that contain an
+ * instruction (i.e., anything other than a label or comment).
+ */
+static int countLines(const char * path, long * lines, long * instructions)
+{
+    char   buffer[BUFSIZ];
+    FILE * fp = fopen(path, "r");
+
+    if ( fp == NULL )
+        return 0;
+    *lines = *instructions = 0;
+    while ( fgets(buffer, BUFSIZ, fp) )
+    {
+        char * p = buffer;
+        char * colon;
+
+        (*lines)++;
+        (void) strtok(buffer, "#\n");
+        if ( *buffer == '#' || *buffer == '\n' )
+            continue;
+        if ( (colon = strchr(p, ':')) != NULL )
+            p = colon + 1;
+        p += strspn(p, " \t\r");
+        if ( *p != '\0' && *p != '\n' )
+            (*instructions)++;
+    }
+    fclose(fp);
+    return 1;
+}
+
+/* Writes one line per benchmark: name, lines/sec, and peak memory.
+ */
+static int writeBaseline(const char * path, BenchResult results[],
+                         int numResults)
+{
+    FILE * fp = fopen(path, "w");
+    int    i;
+
+    if ( fp == NULL )
+        return 0;
+    fprintf(fp, "# benchmark lines/sec maxRSS(KB)\n");
+    for ( i = 0; i < numResults; i++ )
+        fprintf(fp, "%s %.0f %ld\n", results[i].name,
+                results[i].lines / results[i].cpuSeconds,
+                results[i].maxRssKB);
+    fclose(fp);
+    return 1;
+}
+
+/* Compares each result with the matching line of the baseline file and
+ * prints a table of the changes.  Returns the number of benchmarks that
+ * regressed by more than `threshold` percent, or -1 if the baseline
+ * could not be read.
+ */
+static int compareBaseline(const char * path, BenchResult results[],
+                           int numResults, double threshold)
+{
+    char   buffer[BUFSIZ];
+    char   name[256];
+    double baseRate;
+    long   baseRss;
+    int    regressions = 0;
+    int    i;
+    FILE * fp = fopen(path, "r");
+
+    if ( fp == NULL )
+        return -1;
+
+    printf("\n%-34s %12s %12s %9s %10s %10s %9s\n", "benchmark",
+           "base l/cpu-s", "now l/cpu-s", "delta", "base KB", "now KB", "delta");
+    for ( i = 0; i < numResults; i++ )
+    {
+        double rate = results[i].lines / results[i].cpuSeconds;
+        int    found = 0;
+
+        rewind(fp);
+        while ( fgets(buffer, BUFSIZ, fp) )
+        {
+            if ( *buffer != '#' &&
+                 sscanf(buffer, "%255s %lf %ld", name, &baseRate,
+                        &baseRss) == 3 &&
+                 strcmp(name, results[i].name) == SAME )
+            {
+                found = 1;
+                break;
+            }
+        }
+
+        if ( ! found )
+        {
+            printf("%-34s %12s %12.0f %9s %10s %10ld %9s\n",
+                   results[i].name, "-", rate, "new", "-",
+                   results[i].maxRssKB, "new");
+            continue;
+        }
+
+        /* Positive deltas are improvements for throughput but
+         * regressions for memory, so each is checked in its direction.
+         */
+        double rateDelta = 100.0 * (rate - baseRate) / baseRate;
+        double rssDelta = 100.0 * (results[i].maxRssKB - baseRss) /
+                          (baseRss > 0 ? baseRss : 1);
+        int    tooShort = results[i].cpuSeconds < MIN_CHECKED_SECONDS;
+        int    failed = ! tooShort &&
+                        (rateDelta < -threshold || rssDelta > threshold);
+
+        printf("%-34s %12.0f %12.0f %+8.1f%% %10ld %10ld %+8.1f%%%s\n",
+               results[i].name, baseRate, rate, rateDelta, baseRss,
+               results[i].maxRssKB, rssDelta,
+               failed ? "  REGRESSION" : tooShort ? "  (too short)" : "");
+        regressions += failed;
+    }
+
+    fclose(fp);
+    return regressions;
+}
+
+int main(int argc, char * argv[])
+{
+    char   sizesArg[] = "1000,10000,100000";
+    char   densitiesArg[] = "0.02,0.2";
+    char   distancesArg[] = "16,4096";
+    char   mixesArg[] = "mixed";
+    char * assembler = "./assembler";
+    char * generator = "./genMips";
+    char * corpusDir = "bench_corpus";
+    char * seed = "1";
+    char * baselineOut = NULL;
+    char * baselineIn = NULL;
+    double threshold = 10.0;
+    int    repeats = 3;
+    static BenchResult results[MAX_BENCHMARKS];
+    double * times, * cpuTimes;
+    int    numResults = 0;
+    ValueList sizes, densities, distances, mixes;
+    int    n, l, b, m, r, i;
+
+    splitList(sizesArg, &sizes);
+    splitList(densitiesArg, &densities);
+    splitList(distancesArg, &distances);
+    splitList(mixesArg, &mixes);
+
+    /* Process command-line arguments. */
+    for ( i = 1; i + 1 < argc; i += 2 )
+    {
+        if ( strcmp(argv[i], "-n") == SAME )
+            splitList(argv[i + 1], &sizes);
+        else if ( strcmp(argv[i], "-l") == SAME )
+            splitList(argv[i + 1], &densities);
+        else if ( strcmp(argv[i], "-b") == SAME )
+            splitList(argv[i + 1], &distances);
+        else if ( strcmp(argv[i], "-m") == SAME )
+            splitList(argv[i + 1], &mixes);
+        else if ( strcmp(argv[i], "-r") == SAME )
+            repeats = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "-s") == SAME )
+            seed = argv[i + 1];
+        else if ( strcmp(argv[i], "-a") == SAME )
+            assembler = argv[i + 1];
+        else if ( strcmp(argv[i], "-g") == SAME )
+            generator = argv[i + 1];
+        else if ( strcmp(argv[i], "-d") == SAME )
+            corpusDir = argv[i + 1];
+        else if ( strcmp(argv[i], "-w") == SAME )
+            baselineOut = argv[i + 1];
+        else if ( strcmp(argv[i], "-c") == SAME )
+            baselineIn = argv[i + 1];
+        else if ( strcmp(argv[i], "-t") == SAME )
+            threshold = atof(argv[i + 1]);
+        else
+            break;
+    }
+    if ( i < argc || repeats < 1 || threshold < 0 )
+    {
+        fprintf(stderr, "Usage:  %s [-n sizes] [-l densities] "
+                "[-b distances] [-m mixes] [-r repeats] [-s seed]\n"
+                "\t[-a assembler] [-g generator] [-d corpusDir]\n"
+                "\t[-w baselineFile | -c baselineFile [-t threshold]]\n",
+                argv[0]);
+        return 1;
+    }
+    (void) mkdir(corpusDir, 0755);
+
+    /* Generate every program, even if an earlier run did, in case the
+     * generator has changed since.
+     */
+    for ( n = 0; n < sizes.count; n++ )
+    for ( l = 0; l < densities.count; l++ )
+    for ( b = 0; b < distances.count; b++ )
+    for ( m = 0; m < mixes.count; m++ )
+    {
+        BenchResult * result = &results[numResults];
+        char * genArgs[] = { generator, "-n", sizes.items[n],
+                "-l", densities.items[l], "-b", distances.items[b],
+                "-m", mixes.items[m], "-s", seed, NULL };
+        double ignoredTime, ignoredCpu;
+        long   ignoredRss;
+
+        if ( numResults >= MAX_BENCHMARKS )
+            break;
+        snprintf(result->name, sizeof(result->name), "n%s-l%s-b%s-%s-s%s",
+                 sizes.items[n], densities.items[l], distances.items[b],
+                 mixes.items[m], seed);
+        snprintf(result->source, sizeof(result->source), "%s/%s.mips",
+                 corpusDir, result->name);
+        if ( runProgram(genArgs, result->source, &ignoredTime, &ignoredCpu,
+                        &ignoredRss) != 0 )
+        {
+            fprintf(stderr, "Error: could not generate %s.\n",
+                    result->source);
+            (void) unlink(result->source);
+            return 1;
+        }
+        if ( ! countLines(result->source, &result->lines,
+                          &result->instructions) )
+        {
+            fprintf(stderr, "Error: cannot open file %s.\n", result->source);
+            return 1;
+        }
+        result->maxRssKB = 0;
+        numResults++;
+    }
+
+    /* Time the assembler on each program in turn, repeats times over,
+     * so that a slow spell on the machine is spread across all of the
+     * benchmarks rather than falling on the repetitions of one.
+     */
+    times = malloc((numResults * repeats + 1) * sizeof(double));
+    cpuTimes = malloc((numResults * repeats + 1) * sizeof(double));
+    if ( times == NULL || cpuTimes == NULL )
+    {
+        fprintf(stderr, "Error: cannot allocate space in memory.\n");
+        return 1;
+    }
+    for ( r = 0; r < repeats; r++ )
+        for ( i = 0; i < numResults; i++ )
+        {
+            char * asmArgs[] = { assembler, results[i].source, NULL };
+            long   rss;
+
+            if ( runProgram(asmArgs, "/dev/null", &times[i * repeats + r],
+                            &cpuTimes[i * repeats + r], &rss) != 0 )
+            {
+                fprintf(stderr, "Error: %s failed on %s.\n", assembler,
+                        results[i].source);
+                return 1;
+            }
+            if ( rss > results[i].maxRssKB )
+                results[i].maxRssKB = rss;
+        }
+
+    /* Report the median of the repetitions. */
+    printf("%-34s %10s %10s %10s %12s %10s %10s\n", "benchmark", "lines",
+           "seconds", "cpu sec", "lines/sec", "ns/instr", "maxRSS(KB)");
+    for ( i = 0; i < numResults; i++ )
+    {
+        BenchResult * result = &results[i];
+
+        result->seconds = median(&times[i * repeats], repeats);
+        result->cpuSeconds = median(&cpuTimes[i * repeats], repeats);
+        printf("%-34s %10ld %10.4f %10.4f %12.0f %10.1f %10ld\n",
+               result->name, result->lines, result->seconds,
+               result->cpuSeconds, result->lines / result->seconds,
+               result->seconds * 1e9 / (result->instructions > 0 ?
+                                        result->instructions : 1),
+               result->maxRssKB);
+    }
+
+    if ( baselineOut != NULL &&
+         ! writeBaseline(baselineOut, results, numResults) )
+    {
+        fprintf(stderr, "Error: cannot write file %s.\n", baselineOut);
+        return 1;
+    }
+    if ( baselineIn != NULL )
+    {
+        int regressions = compareBaseline(baselineIn, results, numResults,
+                                          threshold);
+        if ( regressions < 0 )
+        {
+            fprintf(stderr, "Error: cannot open file %s.\n", baselineIn);
+            return 1;
+        }
+        if ( regressions > 0 )
+        {
+            printf("\n%d benchmark(s) regressed by more than %.1f%%.\n",
+                   regressions, threshold);
+            return 1;
+        }
+        printf("\nNo benchmark regressed by more than %.1f%%.\n",
+               threshold);
+    }
+
+    free(times);
+    free(cpuTimes);
+    return 0;
+}
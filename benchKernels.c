@@ -0,0 +1,239 @@
+/*
+ * This is a microbenchmark driver for the assembler's hot kernels:
+ * getToken, getNTokens, getInstName, getOpCode/getFunctCode, printReg,
+ * findLabelAddr, printInt, and packBlock (one call packs a block of
+ * PACK_BLOCK_SIZE instructions).  Each kernel is run in isolation over a
+ * small set of representative inputs taken from the sample test file.
+ *
+ * For each kernel the driver runs a warmup phase, then times a number
+ * of samples, each consisting of a fixed number of calls.  It reports
+ * the median and 99th percentile time per call, in nanoseconds.  The
+ * printing kernels write to stdout, so stdout is redirected to
+ * /dev/null while they run; the report is written to the original
+ * standard output.
+ *
+ * The tokenizing kernels modify the line they are given, so each call
+ * first copies a fresh line into a buffer.  The reported times include
+ * that copy, which is small compared to the kernel itself.
+ *
+ * USAGE:
+ *          benchKernels [samples] [callsPerSample]
+ *      Defaults: 200 samples of 10000 calls each.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include <time.h>
+#include <unistd.h>
+
+#define NUM_LABELS 64
+
+static const char * sampleLines[] = {
+    "main:   lw $a0, 0($t0)",
+    "begin:  addi $t0, $zero, 0        # beginning",
+    "        addi $t1, $zero, 1",
+    "loop:   slt $t2, $a0, $t1         # top of loop",
+    "        bne $t2, $zero, finish",
+    "        add $t0, $t0, $t1",
+    "        j loop                    # bottom of loop",
+    "        sll $t1, $t2, 10          # R format instructions",
+    "        jr $s0",
+    "        sw $t1, 100($t2)"
+};
+static const char * sampleOperands[] = {
+    "$a0, 0($t0)", "$t0, $zero, 0", "$t2, $a0, $t1", "$t2, $zero, finish",
+    "$t1, $t2, 10", "$s1, $s2, $s3", "$t1, 100($t2)", "$t1, $t2, 100"
+};
+static const int operandCounts[] = { 3, 3, 3, 3, 3, 3, 3, 3 };
+static const char * sampleNames[] = {
+    "lw", "addi", "slt", "bne", "add", "j", "sll", "jr", "sw", "sltu",
+    "ori", "nor"
+};
+static const char * sampleRegs[] = {
+    "$zero", "$t0", "$t1", "$a0", "$s3", "$ra", "$sp", "$t9"
+};
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* Results are accumulated here so the compiler cannot discard calls. */
+static volatile long sink;
+
+static LabelTableArrayList labelTable;
+static char labelNames[NUM_LABELS][16];
+
+/* Each kernel performs one call on the i'th input. */
+typedef void (*Kernel)(int i);
+
+static void kernelGetToken(int i)
+{
+    char   buffer[BUFSIZ];
+    char * tokBegin = buffer;
+    char * tokEnd;
+
+    strcpy(buffer, sampleLines[i % COUNT(sampleLines)]);
+    getToken(&tokBegin, &tokEnd);
+    sink += tokEnd - tokBegin;
+}
+
+static void kernelGetNTokens(int i)
+{
+    char   buffer[BUFSIZ];
+    char * results[3];
+    int    which = i % COUNT(sampleOperands);
+
+    strcpy(buffer, sampleOperands[which]);
+    sink += getNTokens(buffer, operandCounts[which], results);
+}
+
+static void kernelGetInstName(int i)
+{
+    char   buffer[BUFSIZ];
+    char * instrName;
+    char * restOfLine;
+
+    strcpy(buffer, sampleLines[i % COUNT(sampleLines)]);
+    getInstName(buffer, &instrName, &restOfLine);
+    sink += (instrName != NULL);
+}
+
+static void kernelGetOpCode(int i)
+{
+    char * name = (char *) sampleNames[i % COUNT(sampleNames)];
+    int    opcode = getOpCode(name);
+
+    if ( opcode == 0 )
+        opcode = getFunctCode(name);
+    sink += opcode;
+}
+
+static void kernelPrintReg(int i)
+{
+    printReg((char *) sampleRegs[i % COUNT(sampleRegs)], 1);
+}
+
+static void kernelFindLabelAddr(int i)
+{
+    sink += findLabelAddr(&labelTable, labelNames[(i * 7) % NUM_LABELS]);
+}
+
+static void kernelPrintInt(int i)
+{
+    printInt(i & 0xFFFF, 16);
+}
+
+static FieldBlock fieldBlock;
+
+static void kernelPackBlock(int i)
+{
+    unsigned int words[PACK_BLOCK_SIZE];
+
+    fieldBlock.imm[0] = i & 0xFFFF;
+    packBlock(&fieldBlock, words);
+    sink += words[i % PACK_BLOCK_SIZE];
+}
+
+static int compareDoubles(const void * a, const void * b)
+{
+    double x = *(const double *) a, y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Runs one kernel and prints its median and 99th percentile time per call.
+ */
+static void runKernel(FILE * report, const char * name, Kernel kernel,
+                      int numSamples, int callsPerSample)
+{
+    double * samples = malloc(numSamples * sizeof(double));
+    int      s, i;
+
+    if ( samples == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        return;
+    }
+
+    /* Warm up caches and branch predictors. */
+    for ( i = 0; i < callsPerSample; i++ )
+        kernel(i);
+
+    for ( s = 0; s < numSamples; s++ )
+    {
+        double start = now();
+        for ( i = 0; i < callsPerSample; i++ )
+            kernel(i);
+        samples[s] = (now() - start) * 1e9 / callsPerSample;
+    }
+
+    qsort(samples, numSamples, sizeof(double), compareDoubles);
+    fprintf(report, "%-16s %12.1f %12.1f\n", name, samples[numSamples / 2],
+            samples[(numSamples * 99) / 100 < numSamples ?
+                    (numSamples * 99) / 100 : numSamples - 1]);
+    fflush(report);
+    free(samples);
+}
+
+int main(int argc, char * argv[])
+{
+    int    numSamples = argc > 1 ? atoi(argv[1]) : 200;
+    int    callsPerSample = argc > 2 ? atoi(argv[2]) : 10000;
+    FILE * report;
+    int    i;
+
+    if ( argc > 3 || numSamples < 1 || callsPerSample < 1 )
+    {
+        printError("Usage:  %s [samples] [callsPerSample]\n", argv[0]);
+        return 1;
+    }
+
+    /* Build a label table of moderate size for findLabelAddr. */
+    tableInit(&labelTable);
+    for ( i = 0; i < NUM_LABELS; i++ )
+    {
+        sprintf(labelNames[i], "label%d", i);
+        addLabel(&labelTable, labelNames[i], 4 * i);
+    }
+
+    /* Fill a block of fields for packBlock. */
+    for ( i = 0; i < PACK_BLOCK_SIZE; i++ )
+    {
+        InstrFields fields = { 8, i & 31, (i * 7) & 31, 0, 0, 0, i * 100 };
+        blockAdd(&fieldBlock, &fields);
+    }
+
+    /* Keep the real stdout for the report; send kernel output nowhere. */
+    report = fdopen(dup(STDOUT_FILENO), "w");
+    if ( report == NULL || freopen("/dev/null", "w", stdout) == NULL )
+    {
+        printError("Error: cannot redirect standard output.\n");
+        return 1;
+    }
+
+    fprintf(report, "%-16s %12s %12s\n", "kernel", "median(ns)", "p99(ns)");
+    runKernel(report, "getToken", kernelGetToken, numSamples, callsPerSample);
+    runKernel(report, "getNTokens", kernelGetNTokens, numSamples,
+              callsPerSample);
+    runKernel(report, "getInstName", kernelGetInstName, numSamples,
+              callsPerSample);
+    runKernel(report, "getOpCode", kernelGetOpCode, numSamples,
+              callsPerSample);
+    runKernel(report, "printReg", kernelPrintReg, numSamples, callsPerSample);
+    runKernel(report, "findLabelAddr", kernelFindLabelAddr, numSamples,
+              callsPerSample);
+    runKernel(report, "printInt", kernelPrintInt, numSamples, callsPerSample);
+    runKernel(report, "packBlock", kernelPackBlock, numSamples,
+              callsPerSample);
+    fprintf(report, "(packBlock uses the %s kernel)\n",
+            packKernelName(packKernelInUse()));
+
+    fclose(report);
+    return 0;
+}
@@ -0,0 +1,284 @@
+/*
+ * Control-flow graph: functions to divide a program, taken apart (see
+ * transform.h), into basic blocks joined by the ways control can pass
+ * between them, to remove the blocks control can never reach, and to
+ * draw the graph.
+ *
+ * A block starts at each pinned instruction and after each branch and
+ * jump (beq, bne, j, jal, jr, ...).  Its edges go to:
+ *
+ *      - a branch's target and the block after it;
+ *      - a j's target;
+ *      - a jal's target and the block after it, where the call returns;
+ *      - nowhere, from a jr $ra, since returns are covered by the edges
+ *        from the calls;
+ *      - the block after it, from any other block.
+ *
+ * A jr through any other register, or a jalr, might go anywhere a label
+ * names, so if the program has one, every labeled block is taken to be
+ * reachable.  Falling off the end of the program, or branching outside
+ * it, leads to the exit.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "transform.h"
+#include "instrInfo.h"
+
+#define JR_RA  0x03E00008U      /* jr $ra */
+
+typedef struct {
+        long first, end;        /* its instructions are [first .. end) */
+        long succs[2];          /* successors; numBlocks for the exit */
+        int  numSuccs;
+} Block;
+
+typedef struct {
+        Block * blocks;
+        long    numBlocks;
+        long    numEdges;
+        long  * blockOf;        /* the block of each instruction */
+        char  * reachable;      /* by block */
+        int     indirect;       /* 1 if some jump might go to any label */
+} Cfg;
+
+static void cfgFree(Cfg * cfg)
+{
+    free(cfg->blocks);
+    free(cfg->blockOf);
+    free(cfg->reachable);
+}
+
+/* Returns the block that the instruction at original address target is
+ * the first of, or numBlocks (the exit) if it is outside the program.
+ */
+static long targetBlock(const Cfg * cfg, const Code * code,
+                        const long * positions, long target)
+{
+    long position;
+
+    if ( target < 0 || target % 4 != 0 || target / 4 > code->numOriginal )
+        return cfg->numBlocks;
+    position = positions[target / 4];
+    return position < code->numInstrs ? cfg->blockOf[position]
+                                      : cfg->numBlocks;
+}
+
+/* Builds the graph of code and finds the blocks reachable from the
+ * instruction at original address entry.  Returns 1 if everything went
+ * OK; 0 if memory could not be allocated (an error message has been
+ * printed).
+ */
+static int buildCfg(Cfg * cfg, const Code * code, long entry)
+{
+    long      n = code->numInstrs, i, b, numStack = 0;
+    long    * positions = codePositions(code);
+    long    * stack = malloc((n + 1) * sizeof(long));
+    int       previous = 0;     /* flags of the previous instruction */
+    InstrInfo info;
+
+    memset(cfg, 0, sizeof(Cfg));
+    cfg->blocks = malloc((n + 1) * sizeof(Block));
+    cfg->blockOf = malloc((n + 1) * sizeof(long));
+    cfg->reachable = calloc(n + 1, 1);
+    if ( positions == NULL || stack == NULL || cfg->blocks == NULL ||
+         cfg->blockOf == NULL || cfg->reachable == NULL )
+    {
+        if ( positions != NULL )
+            printError("Error: cannot allocate space in memory.\n");
+        free(positions);
+        free(stack);
+        cfgFree(cfg);
+        return 0;
+    }
+
+    /* Divide the program into blocks. */
+    for ( i = 0; i < n; i++ )
+    {
+        if ( i == 0 || code->instrs[i].pinned ||
+             (previous & (INFO_BRANCH | INFO_JUMP)) )
+        {
+            cfg->blocks[cfg->numBlocks].first = i;
+            cfg->numBlocks++;
+        }
+        cfg->blocks[cfg->numBlocks - 1].end = i + 1;
+        cfg->blockOf[i] = cfg->numBlocks - 1;
+        instrInfo(code->instrs[i].word, 0, &info);
+        previous = info.flags;
+    }
+
+    /* Join them. */
+    for ( b = 0; b < cfg->numBlocks; b++ )
+    {
+        Block           * block = &cfg->blocks[b];
+        const CodeInstr * last = &code->instrs[block->end - 1];
+        int               flags;
+
+        instrInfo(last->word, 0, &info);
+        flags = info.flags;
+        block->numSuccs = 0;
+        if ( (flags & INFO_BRANCH) ||
+             ((flags & INFO_JUMP) && ! (flags & INFO_INDIRECT)) )
+            block->succs[block->numSuccs++] =
+                targetBlock(cfg, code, positions, last->target);
+        if ( (flags & INFO_INDIRECT) && last->word != JR_RA )
+            cfg->indirect = 1;
+        if ( ! (flags & INFO_JUMP) || (flags & INFO_CALL) )
+            block->succs[block->numSuccs++] = b + 1;
+        cfg->numEdges += block->numSuccs;
+    }
+
+    /* Find the blocks reachable from the entry.  Each is marked as it
+     * is pushed, so it is pushed only once.
+     */
+    if ( entry >= 0 && entry % 4 == 0 && entry / 4 < code->numOriginal &&
+         positions[entry / 4] < n )
+    {
+        b = cfg->blockOf[positions[entry / 4]];
+        cfg->reachable[b] = 1;
+        stack[numStack++] = b;
+    }
+    if ( cfg->indirect )
+        for ( b = 0; b < cfg->numBlocks; b++ )
+            if ( code->instrs[cfg->blocks[b].first].pinned &&
+                 ! cfg->reachable[b] )
+            {
+                cfg->reachable[b] = 1;
+                stack[numStack++] = b;
+            }
+    while ( numStack > 0 )
+    {
+        const Block * block = &cfg->blocks[stack[--numStack]];
+        int           s;
+
+        for ( s = 0; s < block->numSuccs; s++ )
+        {
+            b = block->succs[s];
+            if ( b < cfg->numBlocks && ! cfg->reachable[b] )
+            {
+                cfg->reachable[b] = 1;
+                stack[numStack++] = b;
+            }
+        }
+    }
+
+    free(positions);
+    free(stack);
+    return 1;
+}
+
+long removeUnreachable (Code * code, long entry, FILE * statsFp)
+{
+    Cfg         cfg;
+    CodeInstr * out;
+    long        b, i, numNew = 0, removed = 0;
+
+    if ( ! buildCfg(&cfg, code, entry) )
+        return -1;
+    if ( (out = malloc((code->numInstrs + 1) * sizeof(CodeInstr))) == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        cfgFree(&cfg);
+        return -1;
+    }
+
+    for ( b = 0; b < cfg.numBlocks; b++ )
+    {
+        if ( ! cfg.reachable[b] )
+        {
+            removed++;
+            continue;
+        }
+        for ( i = cfg.blocks[b].first; i < cfg.blocks[b].end; i++ )
+            out[numNew++] = code->instrs[i];
+    }
+
+    if ( statsFp != NULL )
+        fprintf(statsFp, "cfg: %ld blocks, %ld edges%s; %ld unreachable "
+                "blocks removed, %ld instructions\n", cfg.numBlocks,
+                cfg.numEdges, cfg.indirect ? ", indirect jumps" : "",
+                removed, code->numInstrs - numNew);
+    codeReplace(code, out, numNew);
+    cfgFree(&cfg);
+    return removed;
+}
+
+int writeCfg (const Code * code, LabelTableArrayList * table, long entry,
+              FILE * out)
+{
+    Cfg           cfg;
+    long        * positions;
+    const char ** names;
+    long          b, i;
+    int           s;
+    InstrInfo     info;
+
+    if ( ! buildCfg(&cfg, code, entry) )
+        return 0;
+    positions = codePositions(code);
+    names = calloc(code->numInstrs + 1, sizeof(char *));
+    if ( positions == NULL || names == NULL )
+    {
+        if ( positions != NULL )
+            printError("Error: cannot allocate space in memory.\n");
+        free(positions);
+        free(names);
+        cfgFree(&cfg);
+        return 0;
+    }
+
+    /* The first label defined at each instruction. */
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        long address = table->addresses[i], position;
+
+        if ( address < 0 || address % 4 != 0 ||
+             address / 4 >= code->numOriginal )
+            continue;
+        position = positions[address / 4];
+        if ( position < code->numInstrs && names[position] == NULL )
+            names[position] = tableLabelName(table, (int) i);
+    }
+
+    fprintf(out, "digraph cfg {\n");
+    fprintf(out, "    node [shape=box, fontname=\"monospace\"];\n");
+    fprintf(out, "    exit [shape=doublecircle, label=\"exit\"];\n");
+    for ( b = 0; b < cfg.numBlocks; b++ )
+    {
+        const Block * block = &cfg.blocks[b];
+        const char  * name = names[block->first];
+
+        instrInfo(code->instrs[block->end - 1].word, 0, &info);
+        fprintf(out, "    b%ld [label=\"%s%saddress %ld, lines %d-%d\\n"
+                "%ld instruction%s\"%s];\n", b, name != NULL ? name : "",
+                name != NULL ? ":\\n" : "", 4 * block->first,
+                code->instrs[block->first].lineNum,
+                code->instrs[block->end - 1].lineNum,
+                block->end - block->first,
+                block->end - block->first == 1 ? "" : "s",
+                cfg.reachable[b] ? "" : ", style=dashed, color=gray");
+        for ( s = 0; s < block->numSuccs; s++ )
+        {
+            if ( block->succs[s] == cfg.numBlocks )
+                fprintf(out, "    b%ld -> exit", b);
+            else
+                fprintf(out, "    b%ld -> b%ld", b, block->succs[s]);
+            if ( block->numSuccs == 2 )
+                fprintf(out, " [label=\"%s\"]", (info.flags & INFO_CALL) ?
+                        (s == 0 ? "call" : "return") :
+                        (s == 0 ? "taken" : "not taken"));
+            fprintf(out, ";\n");
+        }
+    }
+    if ( entry >= 0 && entry % 4 == 0 && entry / 4 < code->numOriginal &&
+         positions[entry / 4] < code->numInstrs )
+        fprintf(out, "    entry [shape=point];\n    entry -> b%ld;\n",
+                cfg.blockOf[positions[entry / 4]]);
+    fprintf(out, "}\n");
+
+    free(positions);
+    free(names);
+    cfgFree(&cfg);
+    return 1;
+}
@@ -0,0 +1,207 @@
+/*
+ * Data cache: functions to model a set-associative data cache and to
+ * report how it did.
+ *
+ * See dataCache.h for a description of the cache.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "dataCache.h"
+
+#define TOP_LINES  10           /* source lines reported */
+
+/* A source line and the misses charged to it. */
+typedef struct {
+        int  lineNum;
+        long misses;
+} LineMisses;
+
+void dataCacheDefaults (DataCacheConfig * config)
+{
+    config->size = 16 * 1024;
+    config->ways = 4;
+    config->lineSize = 32;
+    config->replacement = DCACHE_LRU;
+    config->writeThrough = 0;
+}
+
+static int isPowerOfTwo(unsigned long n)
+{
+    return n > 0 && (n & (n - 1)) == 0;
+}
+
+int dataCacheInit (DataCache * cache, const DataCacheConfig * config,
+                   int numWords)
+{
+    unsigned long setBytes = (unsigned long) config->lineSize * config->ways;
+
+    memset(cache, 0, sizeof(DataCache));
+    if ( config->lineSize < 4 || ! isPowerOfTwo(config->lineSize) )
+    {
+        printError("Error: the cache line size must be a power of two, at "
+                   "least 4 bytes.\n");
+        return 0;
+    }
+    if ( config->ways < 1 || config->size % setBytes != 0 ||
+         ! isPowerOfTwo(config->size / setBytes) )
+    {
+        printError("Error: a %lu-byte cache cannot be divided into a power "
+                   "of two sets of %d lines of %d bytes.\n",
+                   (unsigned long) config->size, config->ways,
+                   config->lineSize);
+        return 0;
+    }
+
+    cache->config = *config;
+    cache->numSets = (int) (config->size / setBytes);
+    while ( (1 << cache->lineShift) < config->lineSize )
+        cache->lineShift++;
+    cache->numWords = numWords;
+    cache->lines = calloc((size_t) cache->numSets * config->ways,
+                          sizeof(CacheLine));
+    cache->missesAt = calloc(numWords + 1, sizeof(long));
+    if ( cache->lines == NULL || cache->missesAt == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        dataCacheFree(cache);
+        return 0;
+    }
+    return 1;
+}
+
+void dataCacheAccess (DataCache * cache, unsigned int address, int write,
+                      long pc)
+{
+    unsigned int lineNumber = address >> cache->lineShift;
+    CacheLine  * set = cache->lines + (size_t) (lineNumber &
+                       (cache->numSets - 1)) * cache->config.ways;
+    unsigned int tag = lineNumber / cache->numSets;
+    CacheLine  * victim = set;
+    int          i;
+
+    cache->now++;
+    if ( write )
+    {
+        cache->writes++;
+        if ( cache->config.writeThrough )
+            cache->memoryWrites++;
+    }
+    else
+        cache->reads++;
+
+    for ( i = 0; i < cache->config.ways; i++ )
+    {
+        if ( set[i].valid && set[i].tag == tag )
+        {
+            if ( cache->config.replacement == DCACHE_LRU )
+                set[i].stamp = cache->now;
+            if ( write && ! cache->config.writeThrough )
+                set[i].dirty = 1;
+            return;
+        }
+
+        /* The victim is an empty line if there is one, or else the one
+         * used (LRU) or filled (FIFO) longest ago.
+         */
+        if ( victim->valid && (! set[i].valid || set[i].stamp < victim->stamp) )
+            victim = &set[i];
+    }
+
+    /* A miss. */
+    if ( write )
+        cache->writeMisses++;
+    else
+        cache->readMisses++;
+    if ( pc >= 0 && pc < cache->numWords )
+        cache->missesAt[pc]++;
+    if ( write && cache->config.writeThrough )
+        return;         /* no write-allocate */
+
+    if ( victim->valid && victim->dirty )
+        cache->writeBacks++;
+    victim->valid = 1;
+    victim->tag = tag;
+    victim->stamp = cache->now;
+    victim->dirty = write;
+}
+
+/* Sorts by misses, most first, then by line number. */
+static int compareLines(const void * a, const void * b)
+{
+    const LineMisses * first = a, * second = b;
+
+    if ( first->misses != second->misses )
+        return first->misses > second->misses ? -1 : 1;
+    return first->lineNum - second->lineNum;
+}
+
+void dataCacheReport (DataCache * cache, const Image * image,
+                      long instructions, FILE * out)
+{
+    const DataCacheConfig * config = &cache->config;
+    long         accesses = cache->reads + cache->writes;
+    long         misses = cache->readMisses + cache->writeMisses;
+    LineMisses * lines = malloc((image->numWords + 1) * sizeof(LineMisses));
+    int          numLines = 0, i;
+
+    fprintf(out, "Data cache: %lu bytes, %d-way, %d-byte lines, %d sets, "
+            "%s, %s\n", (unsigned long) config->size, config->ways,
+            config->lineSize, cache->numSets,
+            config->replacement == DCACHE_LRU ? "LRU" : "FIFO",
+            config->writeThrough ? "write-through" : "write-back");
+    fprintf(out, "accesses: %ld (%ld reads, %ld writes)\n", accesses,
+            cache->reads, cache->writes);
+    fprintf(out, "misses: %ld (%ld reads, %ld writes); hit rate %.2f%%, "
+            "%.2f misses per 1000 instructions\n", misses, cache->readMisses,
+            cache->writeMisses,
+            accesses > 0 ? 100.0 * (accesses - misses) / accesses : 0.0,
+            instructions > 0 ? 1000.0 * misses / instructions : 0.0);
+    if ( config->writeThrough )
+        fprintf(out, "memory writes: %ld\n", cache->memoryWrites);
+    else
+        fprintf(out, "dirty lines written back: %ld\n", cache->writeBacks);
+
+    if ( lines == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        return;
+    }
+
+    /* Several instructions can share a source line (a pseudo-instruction,
+     * say), and the words are in line order, so adjacent words with the
+     * same line are added together.
+     */
+    for ( i = 0; i < image->numWords; i++ )
+    {
+        if ( cache->missesAt[i] == 0 )
+            continue;
+        if ( numLines > 0 && lines[numLines - 1].lineNum == image->lineNums[i] )
+            lines[numLines - 1].misses += cache->missesAt[i];
+        else
+        {
+            lines[numLines].lineNum = image->lineNums[i];
+            lines[numLines].misses = cache->missesAt[i];
+            numLines++;
+        }
+    }
+    qsort(lines, numLines, sizeof(LineMisses), compareLines);
+
+    if ( numLines > 0 )
+    {
+        fprintf(out, "\n%6s %10s %8s\n", "line", "misses", "share");
+        for ( i = 0; i < numLines && i < TOP_LINES; i++ )
+            fprintf(out, "%6d %10ld %7.2f%%\n", lines[i].lineNum,
+                    lines[i].misses, 100.0 * lines[i].misses / misses);
+    }
+    free(lines);
+}
+
+void dataCacheFree (DataCache * cache)
+{
+    free(cache->lines);
+    free(cache->missesAt);
+    cache->lines = NULL;
+    cache->missesAt = NULL;
+}
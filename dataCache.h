@@ -0,0 +1,100 @@
+/*
+ * Data cache: a model of a set-associative data cache, which --run
+ * (see run.h) drives with the address of every lw and sw.
+ *
+ * The cache holds size bytes in lines of lineSize bytes, in sets of
+ * ways lines each; an address's set is its line number modulo the
+ * number of sets.  When a set is full, the line replaced is the least
+ * recently used (LRU) or the first one brought in (FIFO).  Writes are
+ * either write-back with write-allocate (a written line is marked dirty
+ * and written to memory when it is replaced) or write-through without
+ * write-allocate (every write goes to memory, and a write miss does not
+ * bring the line in).
+ *
+ * Every miss is charged to the instruction that caused it, so that the
+ * source lines missing most often can be reported.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _DATA_CACHE_H
+#define _DATA_CACHE_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "image.h"
+
+/* THE DATA STRUCTURES */
+
+#define DCACHE_LRU   0
+#define DCACHE_FIFO  1
+
+typedef struct {
+        size_t size;            /* bytes */
+        int    ways;            /* lines per set */
+        int    lineSize;        /* bytes */
+        int    replacement;     /* DCACHE_LRU or DCACHE_FIFO */
+        int    writeThrough;    /* 1: write-through, no write-allocate;
+                                   0: write-back, write-allocate */
+} DataCacheConfig;
+
+typedef struct {
+        unsigned int tag;
+        int          valid, dirty;
+        long         stamp;     /* time of the last use (LRU) or of the
+                                   fill (FIFO) */
+} CacheLine;
+
+typedef struct {
+        DataCacheConfig config;
+        CacheLine * lines;      /* ways lines for each set */
+        int    numSets;
+        int    lineShift;       /* log2(lineSize) */
+        long   now;             /* accesses so far */
+        long   reads, writes;
+        long   readMisses, writeMisses;
+        long   writeBacks;      /* dirty lines written to memory */
+        long   memoryWrites;    /* writes sent to memory (write-through) */
+        long * missesAt;        /* misses caused by each instruction */
+        int    numWords;
+} DataCache;
+
+
+/* THE FUNCTIONS */
+
+void dataCacheDefaults (DataCacheConfig * config);
+        /* Postcondition: config describes a 16 KB, 4-way, LRU,
+         *      write-back cache with 32-byte lines.
+         */
+
+int dataCacheInit (DataCache * cache, const DataCacheConfig * config,
+                   int numWords);
+        /* Postcondition: cache is empty and set up as config describes,
+         *      for a program of numWords instructions.
+         * Returns 1 if everything went OK; 0 if config does not describe
+         *      a cache (sizes not powers of two, say) or memory could not
+         *      be allocated (an error message has been printed).
+         */
+
+void dataCacheAccess (DataCache * cache, unsigned int address, int write,
+                      long pc);
+        /* Postcondition: a read (or, if write is 1, a write) of the word
+         *      at address by instruction number pc has gone through the
+         *      cache.
+         */
+
+void dataCacheReport (DataCache * cache, const Image * image,
+                      long instructions, FILE * out);
+        /* Postcondition: the hit rate, misses per thousand instructions
+         *      (of the instructions run), memory traffic, and the source
+         *      lines of image that missed most have been written to out.
+         */
+
+void dataCacheFree (DataCache * cache);
+        /* Postcondition: the memory used by cache has been released.
+         */
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * long fillDelaySlots (Code * code, FILE * statsFp)
+ *      @param  code  the program, taken apart (see transform.h)
+ *      @param  statsFp  where to report what was done (NULL for nowhere)
+ *      @return the number of delay slots filled with moved instructions,
+ *              or -1 if memory could not be allocated
+ *
+ * This function prepares a program for hardware with branch delay slots,
+ * on which the instruction after a branch or jump runs whether or not the
+ * branch is taken.  The program is assumed to have been written without
+ * them, as the assembler otherwise assumes, except that a nop right after
+ * a branch or jump is taken to be an empty slot already.
+ *
+ * For each branch or jump (beq, bne, j, jal, jr, ...) it looks back
+ * through the branch's block, up to SEARCH_LIMIT instructions, for an
+ * instruction that can run after the branch instead of before it, and
+ * moves the nearest one it finds into the slot.  An instruction can be
+ * moved if it is not pinned (see transform.h) and nothing it passes --
+ * the instructions after it in the block, and the branch itself -- reads
+ * what it writes, writes what it reads or writes, or is a load or store
+ * that conflicts with it (two loads do not conflict).  Nothing is moved
+ * past a syscall or an unsupported word, and nothing is moved into the
+ * slot of a branch that is itself the target of a branch or jump, since
+ * the moved instruction would then also run on that path.
+ *
+ * A slot that cannot be filled holds a nop, inserted if the program did
+ * not already have one there.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "transform.h"
+#include "instrInfo.h"
+
+#define SEARCH_LIMIT  16        /* instructions looked back at */
+
+#define NOP  0x00000000U        /* sll $zero, $zero, 0 */
+
+/* Returns 1 if the instruction described by moved can be moved past the
+ * one described by other; 0 if not.
+ */
+static int independent(const InstrInfo * moved, const InstrInfo * other)
+{
+    int memory = INFO_LOAD | INFO_STORE;
+
+    if ( (moved->writes & (other->reads | other->writes)) ||
+         (moved->reads & other->writes) || (other->flags & INFO_BARRIER) )
+        return 0;
+    return ! ((moved->flags & memory) && (other->flags & memory) &&
+              ((moved->flags | other->flags) & INFO_STORE));
+}
+
+long fillDelaySlots (Code * code, FILE * statsFp)
+{
+    long        n = code->numInstrs, i, j, k, numNew = 0;
+    CodeInstr * instrs = code->instrs;
+    CodeInstr * out = malloc((2 * n + 1) * sizeof(CodeInstr));
+    InstrInfo * infos = malloc((n + 1) * sizeof(InstrInfo));
+    long      * filler = malloc((n + 1) * sizeof(long));
+    char      * skip = calloc(n + 1, 1);
+    long        branches = 0, filled = 0, hadNop = 0, inserted = 0;
+    int         control = INFO_BRANCH | INFO_JUMP;
+
+    if ( out == NULL || infos == NULL || filler == NULL || skip == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(out);
+        free(infos);
+        free(filler);
+        free(skip);
+        return -1;
+    }
+    for ( i = 0; i < n; i++ )
+        instrInfo(instrs[i].word, 0, &infos[i]);
+
+    /* Choose the instruction for each slot. */
+    for ( i = 0; i < n; i++ )
+    {
+        filler[i] = -1;
+        if ( ! (infos[i].flags & control) )
+            continue;
+        branches++;
+        for ( j = i - 1; ! instrs[i].pinned && j >= 0 && i - j <= SEARCH_LIMIT;
+              j-- )
+        {
+            if ( infos[j].flags & control )
+                break;          /* the block starts after it */
+            if ( ! instrs[j].pinned && instrs[j].word != NOP &&
+                 ! (infos[j].flags & INFO_BARRIER) )
+            {
+                for ( k = j + 1; k <= i && independent(&infos[j], &infos[k]);
+                      k++ )
+                    ;
+                if ( k > i )
+                {
+                    filler[i] = j;
+                    skip[j] = 1;
+                    break;
+                }
+            }
+            if ( instrs[j].pinned )
+                break;          /* the block starts here */
+        }
+    }
+
+    /* Lay the program out again, with a slot after each branch. */
+    for ( i = 0; i < n; i++ )
+    {
+        int nopNext;
+
+        if ( skip[i] )
+            continue;
+        out[numNew++] = instrs[i];
+        if ( ! (infos[i].flags & control) )
+            continue;
+        nopNext = i + 1 < n && instrs[i + 1].word == NOP &&
+                  ! instrs[i + 1].pinned && ! skip[i + 1];
+        if ( filler[i] >= 0 )
+        {
+            out[numNew++] = instrs[filler[i]];
+            filled++;
+            if ( nopNext )
+                skip[i + 1] = 1;        /* the nop is not needed */
+        }
+        else if ( nopNext )
+            hadNop++;
+        else
+        {
+            out[numNew].word = NOP;
+            out[numNew].lineNum = instrs[i].lineNum;
+            out[numNew].origin = -1;
+            out[numNew].target = -1;
+            out[numNew++].pinned = 0;
+            inserted++;
+        }
+    }
+    codeReplace(code, out, numNew);
+
+    if ( statsFp != NULL )
+        fprintf(statsFp, "delay slots: %ld branches and jumps; %ld slots "
+                "filled, %ld already held a nop, %ld nops inserted\n",
+                branches, filled, hadNop, inserted);
+
+    free(infos);
+    free(filler);
+    free(skip);
+    return filled;
+}
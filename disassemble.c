@@ -0,0 +1,375 @@
+/**
+ * long disassemble (FILE * fp, LabelTableArrayList * labels, int format,
+ *                   FILE * statsFp)
+ *      @param  fp  pointer to an open file from which to read words
+ *      @param  labels  a pointer to a Label Table naming addresses in the
+ *                      program (NULL if there are none)
+ *      @param  format  the format of the words: FORMAT_BINARY,
+ *                      FORMAT_RAW, or FORMAT_HEX (as written by
+ *                      formatWord)
+ *      @param  statsFp  where to print statistics (NULL for none)
+ *      @return the number of words disassembled, or -1 if the input
+ *              holds something that is not a word in format
+ *
+ * This function does the reverse of pass2: it reads assembled words and
+ * prints them as MIPS source, one instruction per line, to stdout.  The
+ * first word is at address 0.
+ *
+ * Each word is decoded with the same templates the assembler encodes
+ * with (see decodeTemplate), so any instruction the assembler supports
+ * can be disassembled, and the output assembles back into the same
+ * words.  A word that is not a supported instruction is printed as a
+ * .word directive, which the assembler places unchanged.
+ *
+ * A label in labels is printed at the start of the line of the
+ * instruction at its address (on a line of its own if there are several
+ * at that address), and in place of the offset or target of any branch
+ * or jump to that address.  A branch or jump to an address with no label
+ * is printed with the offset or target as a number.
+ *
+ * Words are read, and lines written, through large buffers, and numbers
+ * are formatted without printf, so that millions of words are
+ * disassembled per second.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include <time.h>
+
+#define BUFFER_SIZE (64 * 1024)
+
+static const char * REGISTER_NAMES[32] = {
+    "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+    "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+    "$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+};
+
+/* Input, read a buffer at a time. */
+typedef struct {
+        FILE * fp;
+        int    format;
+        size_t pos, length;     /* unread bytes are buffer[pos .. length) */
+        char   buffer[BUFFER_SIZE];
+} Reader;
+
+/* Output, written a buffer at a time. */
+typedef struct {
+        size_t length;
+        char   buffer[BUFFER_SIZE];
+} Writer;
+
+/* A label's address and entry number, for sorting by address. */
+typedef struct {
+        int address;
+        int index;
+} Symbol;
+
+/* Makes sure at least n bytes (if there are that many left in the
+ * input) follow reader->pos in the buffer.  Returns the number that do.
+ */
+static size_t fill(Reader * reader, size_t n)
+{
+    if ( reader->length - reader->pos < n )
+    {
+        memmove(reader->buffer, reader->buffer + reader->pos,
+                reader->length - reader->pos);
+        reader->length -= reader->pos;
+        reader->pos = 0;
+        reader->length += fread(reader->buffer + reader->length, 1,
+                                BUFFER_SIZE - reader->length, reader->fp);
+    }
+    return reader->length - reader->pos;
+}
+
+/* Reads the next word.  Returns 1 if there is one; 0 at the end of the
+ * input; -1 if the input does not hold a word in the reader's format.
+ */
+static int readWord(Reader * reader, unsigned int * word)
+{
+    const unsigned char * next;
+    int                   digits, i;
+
+    if ( reader->format == FORMAT_RAW )
+    {
+        size_t left = fill(reader, 4);
+
+        if ( left < 4 )
+            return left == 0 ? 0 : -1;
+        next = (const unsigned char *) reader->buffer + reader->pos;
+        *word = (unsigned int) next[0] << 24 | (unsigned int) next[1] << 16 |
+                (unsigned int) next[2] << 8 | next[3];
+        reader->pos += 4;
+        return 1;
+    }
+
+    /* Text: skip the newline (and any other white space) before it. */
+    for ( ;; )
+    {
+        if ( reader->pos == reader->length && fill(reader, 1) == 0 )
+            return 0;
+        if ( ! isspace((unsigned char) reader->buffer[reader->pos]) )
+            break;
+        reader->pos++;
+    }
+
+    digits = reader->format == FORMAT_HEX ? 8 : 32;
+    if ( fill(reader, digits) < (size_t) digits )
+        return -1;
+    next = (const unsigned char *) reader->buffer + reader->pos;
+    *word = 0;
+    if ( reader->format == FORMAT_HEX )
+        for ( i = 0; i < 8; i++ )
+        {
+            unsigned int digit = next[i] - (unsigned int) '0';
+
+            if ( digit > 9 )
+            {
+                digit = (next[i] | 0x20) - (unsigned int) 'a' + 10;
+                if ( digit < 10 || digit > 15 )
+                    return -1;
+            }
+            *word = *word << 4 | digit;
+        }
+    else
+        for ( i = 0; i < 32; i++ )
+        {
+            if ( next[i] != '0' && next[i] != '1' )
+                return -1;
+            *word = *word << 1 | (unsigned int) (next[i] - '0');
+        }
+    reader->pos += digits;
+    return 1;
+}
+
+static void flush(Writer * writer)
+{
+    fwrite(writer->buffer, 1, writer->length, stdout);
+    writer->length = 0;
+}
+
+static void put(Writer * writer, const char * text, size_t length)
+{
+    if ( writer->length + length > BUFFER_SIZE )
+    {
+        flush(writer);
+        if ( length > BUFFER_SIZE )
+        {
+            fwrite(text, 1, length, stdout);
+            return;
+        }
+    }
+    memcpy(writer->buffer + writer->length, text, length);
+    writer->length += length;
+}
+
+static void putString(Writer * writer, const char * text)
+{
+    put(writer, text, strlen(text));
+}
+
+static void putNumber(Writer * writer, long value)
+{
+    char           digits[24];
+    char         * start = digits + sizeof(digits);
+    unsigned long  magnitude = value < 0 ? 0UL - (unsigned long) value
+                                         : (unsigned long) value;
+
+    do
+        *--start = (char) ('0' + magnitude % 10);
+    while ( (magnitude /= 10) > 0 );
+    if ( value < 0 )
+        *--start = '-';
+    put(writer, start, digits + sizeof(digits) - start);
+}
+
+static int compareSymbols(const void * a, const void * b)
+{
+    const Symbol * first = a, * second = b;
+
+    if ( first->address != second->address )
+        return first->address < second->address ? -1 : 1;
+    return first->index - second->index;
+}
+
+/* Returns the name of the first label at address, or NULL if there is
+ * none.
+ */
+static const char * labelAt(LabelTableArrayList * labels,
+                            const Symbol * symbols, int numSymbols,
+                            long address)
+{
+    int low = 0, high = numSymbols;
+
+    while ( low < high )
+    {
+        int middle = low + (high - low) / 2;
+
+        if ( symbols[middle].address < address )
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    if ( low < numSymbols && symbols[low].address == address )
+        return tableLabelName(labels, symbols[low].index);
+    return NULL;
+}
+
+/* Writes the instruction in word, at address, as source. */
+static void putInstruction(Writer * writer, unsigned int word, long address,
+                           LabelTableArrayList * labels,
+                           const Symbol * symbols, int numSymbols)
+{
+    static const char    hex[] = "0123456789abcdef";
+    const InstrTemplate * template = decodeTemplate(word);
+    int                   i;
+
+    if ( template == NULL )
+    {
+        char text[] = ".word 0x00000000";
+
+        for ( i = 0; i < 8; i++ )
+            text[8 + i] = hex[(word >> (28 - 4 * i)) & 0xF];
+        put(writer, text, sizeof(text) - 1);
+        return;
+    }
+
+    putString(writer, template->name);
+
+    /* Loads and stores: rt, offset(rs). */
+    if ( template->numOperands == 3 && template->base >> 26 >= 32 )
+    {
+        put(writer, " ", 1);
+        putString(writer, REGISTER_NAMES[fieldValue(&template->slots[0],
+                                                    word)]);
+        put(writer, ", ", 2);
+        putNumber(writer, fieldValue(&template->slots[1], word));
+        put(writer, "(", 1);
+        putString(writer, REGISTER_NAMES[fieldValue(&template->slots[2],
+                                                    word)]);
+        put(writer, ")", 1);
+        return;
+    }
+
+    for ( i = 0; i < template->numOperands; i++ )
+    {
+        const OperandSlot * slot = &template->slots[i];
+        long                value = fieldValue(slot, word);
+        const char        * label = NULL;
+
+        put(writer, i == 0 ? " " : ", ", i == 0 ? 1 : 2);
+        if ( slot->kind == OPND_REG )
+        {
+            putString(writer, REGISTER_NAMES[value]);
+            continue;
+        }
+        if ( slot->kind == OPND_BRANCH )
+            label = labelAt(labels, symbols, numSymbols,
+                            address + 4 + 4 * value);
+        else if ( slot->kind == OPND_JUMP )
+            label = labelAt(labels, symbols, numSymbols,
+                            ((address + 4) & 0xF0000000L) | value << 2);
+        if ( label != NULL )
+            putString(writer, label);
+        else
+            putNumber(writer, value);
+    }
+}
+
+/* Writes the labels at address, before the instruction there (the last
+ * one on the same line).  *next is the first label not yet written.
+ */
+static void putLabels(Writer * writer, LabelTableArrayList * labels,
+                      const Symbol * symbols, int numSymbols, int * next,
+                      long address)
+{
+    /* Labels at addresses that are not those of a word are skipped. */
+    while ( *next < numSymbols && symbols[*next].address < address )
+        (*next)++;
+    while ( *next < numSymbols && symbols[*next].address == address )
+    {
+        putString(writer, tableLabelName(labels, symbols[*next].index));
+        (*next)++;
+        if ( *next < numSymbols && symbols[*next].address == address )
+            put(writer, ":\n", 2);
+        else
+            put(writer, ":", 1);
+    }
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+long disassemble (FILE * fp, LabelTableArrayList * labels, int format,
+                  FILE * statsFp)
+{
+    Reader      * reader = malloc(sizeof(Reader));
+    Writer      * writer = malloc(sizeof(Writer));
+    Symbol      * symbols = NULL;
+    int           numSymbols = labels == NULL ? 0 : labels->nbrLabels;
+    int           next = 0, i, result;
+    long          numWords = 0;
+    unsigned int  word;
+    double        start = now(), seconds;
+
+    if ( reader == NULL || writer == NULL ||
+         (symbols = malloc((numSymbols + 1) * sizeof(Symbol))) == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(reader);
+        free(writer);
+        return -1;
+    }
+    reader->fp = fp;
+    reader->format = format;
+    reader->pos = reader->length = 0;
+    writer->length = 0;
+
+    /* Sort the labels by address, to find them by address. */
+    for ( i = 0; i < numSymbols; i++ )
+    {
+        symbols[i].address = labels->addresses[i];
+        symbols[i].index = i;
+    }
+    qsort(symbols, numSymbols, sizeof(Symbol), compareSymbols);
+
+    while ( (result = readWord(reader, &word)) == 1 )
+    {
+        long address = 4 * numWords;
+
+        putLabels(writer, labels, symbols, numSymbols, &next, address);
+        put(writer, "\t", 1);
+        putInstruction(writer, word, address, labels, symbols, numSymbols);
+        put(writer, "\n", 1);
+        numWords++;
+    }
+
+    /* Labels at the end of the program are on lines of their own. */
+    putLabels(writer, labels, symbols, numSymbols, &next, 4 * numWords);
+    if ( next > 0 && symbols[next - 1].address == 4 * numWords )
+        put(writer, "\n", 1);
+    flush(writer);
+
+    if ( result == -1 )
+        printError("Error: word %ld of the input is not a valid %s word.\n",
+                   numWords + 1, format == FORMAT_RAW ? "raw" :
+                   format == FORMAT_HEX ? "hex" : "binary");
+    if ( statsFp != NULL )
+    {
+        seconds = now() - start;
+        fprintf(statsFp, "disassembly: %ld words, %d labels, %.3f s, "
+                "%.1f million words per second\n", numWords, numSymbols,
+                seconds, seconds > 0 ? numWords / seconds / 1e6 : 0.0);
+    }
+
+    free(symbols);
+    free(reader);
+    free(writer);
+    return result == -1 ? -1 : numWords;
+}
@@ -0,0 +1,98 @@
+/*
+ * dumpObject: prints the contents of object files (see objectFile.h) as
+ * text, so that they can be inspected.
+ *
+ * USAGE:
+ *          dumpObject file.o ...
+ *
+ * OUTPUT:
+ *      For each object file, its header -- the offset, size, and count
+ *      of each section -- followed by the sections themselves:
+ *
+ *      u0.o: MIPS object version 1, 1184 bytes
+ *      section      offset     size    count
+ *      words            96      400      100
+ *      ...
+ *      words 100               word number and word, in hexadecimal
+ *      00000000 0c000000
+ *      ...
+ *      globals 1               address (in the unit), hash, and name
+ *      00000008 5d3a9e0f loop
+ *      externals 1             hash and name
+ *      2b81c4d7 helper
+ *      relocations 1           kind, word number, line number, and
+ *      J 0 5 helper            external label (- for none)
+ *
+ *      where the kind is B (a branch to an external label), J (a jump to
+ *      an external label), or L (a jump to a label in the unit).
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "objectFile.h"
+
+static const char * SECTION_NAMES[] = { "words", "globals", "externals",
+                                        "relocations" };
+
+static const char RELOC_LETTERS[] = " BJL";     /* by kind */
+
+static void dumpUnit(ObjectUnit * unit)
+{
+    const ObjectHeader * header = unit->map;
+    int                  i;
+
+    printf("%s: MIPS object version %u, %u bytes\n", unit->name,
+           header->version, header->fileSize);
+    printf("%-12s %8s %8s %8s\n", "section", "offset", "size", "count");
+    for ( i = 0; i < OBJECT_SECTIONS; i++ )
+        printf("%-12s %8u %8u %8u\n", SECTION_NAMES[i],
+               header->sections[i].offset, header->sections[i].size,
+               header->sections[i].count);
+
+    printf("words %d\n", unit->numWords);
+    for ( i = 0; i < unit->numWords; i++ )
+        printf("%08x %08x\n", (unsigned) i, unit->words[i]);
+
+    printf("globals %d\n", unit->globals.nbrLabels);
+    for ( i = 0; i < unit->globals.nbrLabels; i++ )
+        printf("%08x %08x %s\n", (unsigned) unit->globals.addresses[i],
+               unit->globals.hashes[i], tableLabelName(&unit->globals, i));
+
+    printf("externals %d\n", unit->externals.nbrLabels);
+    for ( i = 0; i < unit->externals.nbrLabels; i++ )
+        printf("%08x %s\n", unit->externals.hashes[i],
+               tableLabelName(&unit->externals, i));
+
+    printf("relocations %d\n", unit->numRelocs);
+    for ( i = 0; i < unit->numRelocs; i++ )
+    {
+        const Relocation * reloc = &unit->relocs[i];
+
+        printf("%c %d %d %s\n", RELOC_LETTERS[reloc->kind], reloc->word,
+               reloc->lineNum, reloc->external == -1 ? "-" :
+               tableLabelName(&unit->externals, reloc->external));
+    }
+}
+
+int main (int argc, char *argv[])
+{
+    ObjectUnit unit;
+    int        i, errors = 0;
+
+    if ( argc < 2 )
+    {
+        fprintf(stderr, "Usage: %s file.o ...\n", argv[0]);
+        return 1;
+    }
+
+    for ( i = 1; i < argc; i++ )
+    {
+        if ( objectRead(&unit, argv[i]) )
+            dumpUnit(&unit);
+        else
+            errors++;
+        objectFree(&unit);
+    }
+    return errors > 0;
+}
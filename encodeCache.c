@@ -0,0 +1,196 @@
+/*
+ * Encode cache: functions to look up and remember the machine code for
+ * instructions that have already been encoded.
+ *
+ * See encodeCache.h for a description of the cache.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "encodeCache.h"
+
+#include <stdatomic.h>
+
+#define IS_END(c)  ((c) == '\0' || (c) == '#')   /* a comment ends a line */
+#define FNV_BASIS  2166136261u          /* FNV-1a hash constants */
+#define FNV_PRIME  16777619u
+
+static int cacheSize = CACHE_DEFAULT_ENTRIES;
+
+/* Statistics of every cache freed so far (caches may be freed by
+ * different threads).
+ */
+static atomic_long totalLookups, totalHits, totalStores, totalSkipped;
+static atomic_int  entriesUsed;         /* entries per cache; 0 if off */
+
+/* Builds the normalized text of the instruction on the line inst: its
+ * name and operand tokens, separated by single spaces, found exactly as
+ * getInstName and getNTokens find them (a token starts with any
+ * character but whitespace, and runs until whitespace or punctuation;
+ * the character that ends it is skipped).  Lines with the same key have
+ * the same tokens, so they decode the same way.  The key is hashed
+ * (FNV-1a) as it is built.  Returns the length of the key, or 0 if the
+ * line has no instruction or is too long to cache.
+ */
+static int makeKey(const char * inst, char * key, unsigned int * hash)
+{
+    const char * p = inst;
+    unsigned int h = FNV_BASIS;
+    int          length = 0;
+    int          first = 1;     /* the token is the first on the line */
+    int          isName = 1;    /* the token is the instruction name */
+
+    if ( *p == '#' )
+        return 0;
+
+    for ( ;; )
+    {
+        /* Skip whitespace; stop at the end of the line. */
+        while ( ! IS_END(*p) && isspace((unsigned char) *p) )
+            p++;
+        if ( IS_END(*p) )
+            break;
+
+        /* Copy (and hash) one token, after a space if it is not the
+         * first in the key.
+         */
+        if ( length > 0 )
+        {
+            if ( length == CACHE_KEY_SIZE )
+                return 0;
+            key[length++] = ' ';
+            h = (h ^ ' ') * FNV_PRIME;
+        }
+        do
+        {
+            if ( length == CACHE_KEY_SIZE )
+                return 0;
+            h = (h ^ (unsigned char) *p) * FNV_PRIME;
+            key[length++] = *p++;
+        } while ( ! IS_END(*p) && *p != ',' && *p != '(' && *p != ')' &&
+                  *p != ':' && ! isspace((unsigned char) *p) );
+
+        if ( first && *p == ':' )
+        {
+            /* A label; the instruction name is the next token. */
+            length = 0;
+            h = FNV_BASIS;
+        }
+        else if ( IS_END(*p) )
+        {
+            if ( isName )
+                return 0;       /* getInstName expects more after it */
+            break;
+        }
+        else
+            isName = 0;
+        first = 0;
+        p++;            /* skip the character that ended the token */
+    }
+
+    *hash = h;
+    return length;
+}
+
+void setCacheSize (int numEntries)
+{
+    cacheSize = numEntries;
+}
+
+void cacheInit (EncodeCache * cache)
+{
+    memset(cache, 0, sizeof(EncodeCache));
+    if ( cacheSize <= 0 || debug_is_on() )
+        return;
+
+    for ( cache->numEntries = 1; cache->numEntries < cacheSize; )
+        cache->numEntries *= 2;
+    cache->entries = calloc(cache->numEntries, sizeof(CacheEntry));
+    if ( cache->entries == NULL )
+        cache->numEntries = 0;
+}
+
+int cacheDecode (EncodeCache * cache, char * inst, int lineNum, int PC,
+                 LabelTableArrayList * table, InstrFields * fields,
+                 unsigned int * word, LabelRef * unresolved)
+{
+    char         key[CACHE_KEY_SIZE];
+    unsigned int hash;
+    int          length, result;
+    CacheEntry * entry;
+
+    if ( cache->skip > 0 )
+    {
+        cache->skip--;
+        cache->skipped++;
+        return decodeLine(inst, lineNum, PC, table, fields, unresolved);
+    }
+    if ( cache->entries == NULL ||
+         (length = makeKey(inst, key, &hash)) == 0 )
+        return decodeLine(inst, lineNum, PC, table, fields, unresolved);
+
+    /* Set the cache aside for a while if it is not paying for itself. */
+    cache->lookups++;
+    if ( ++cache->windowLookups == CACHE_WINDOW )
+    {
+        if ( cache->windowHits < CACHE_WINDOW / 8 )
+            cache->skip = CACHE_BACKOFF;
+        cache->windowLookups = cache->windowHits = 0;
+    }
+
+    entry = &cache->entries[hash & (cache->numEntries - 1)];
+    if ( entry->length == length && entry->hash == hash &&
+         memcmp(entry->key, key, length) == SAME )
+    {
+        cache->hits++;
+        cache->windowHits++;
+        if ( unresolved != NULL )
+            unresolved->kind = REF_NONE;
+        *word = entry->word;
+        return ASM_CACHED;
+    }
+
+    /* Not found: decode the line, and keep its word unless it depends
+     * on where the instruction is (branches and jumps).
+     */
+    result = decodeLine(inst, lineNum, PC, table, fields, unresolved);
+    if ( result == ASM_OK && ! isBranchOrJump(fields) )
+    {
+        entry->hash = hash;
+        entry->word = packFields(fields);
+        entry->length = length;
+        memcpy(entry->key, key, length);
+        cache->stores++;
+    }
+    return result;
+}
+
+void cacheFree (EncodeCache * cache)
+{
+    atomic_fetch_add(&totalLookups, cache->lookups);
+    atomic_fetch_add(&totalHits, cache->hits);
+    atomic_fetch_add(&totalStores, cache->stores);
+    atomic_fetch_add(&totalSkipped, cache->skipped);
+    if ( cache->numEntries > 0 )
+        atomic_store(&entriesUsed, cache->numEntries);
+    free(cache->entries);
+    memset(cache, 0, sizeof(EncodeCache));
+}
+
+void cachePrintStats (FILE * fp)
+{
+    long lookups = atomic_load(&totalLookups);
+    long hits = atomic_load(&totalHits);
+
+    if ( atomic_load(&entriesUsed) == 0 )
+    {
+        fprintf(fp, "encode cache: not used\n");
+        return;
+    }
+    fprintf(fp, "encode cache: %ld hits in %ld lookups (%.1f%%), "
+            "%ld words stored, %ld lines skipped; %d entries per thread\n",
+            hits, lookups, lookups > 0 ? 100.0 * hits / lookups : 0.0,
+            (long) atomic_load(&totalStores),
+            (long) atomic_load(&totalSkipped), atomic_load(&entriesUsed));
+}
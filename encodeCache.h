@@ -0,0 +1,97 @@
+/*
+ * Encode cache: remembering the machine code for instructions that have
+ * already been encoded.
+ *
+ * Real programs repeat the same instructions over and over (think of
+ * "addi $sp, $sp, -4" or "jr $ra"), and an instruction that does not
+ * refer to a label always encodes to the same word, wherever it is.  An
+ * encode cache maps the normalized text of such an instruction -- its
+ * name and operand tokens, exactly as getInstName and getNTokens would
+ * find them, without any label, comment, or extra whitespace -- to its
+ * word, so that a repeated line skips getNTokens, the register and
+ * operand lookups, and packing altogether.
+ *
+ * The cache has a fixed number of entries (set with setCacheSize), each
+ * holding one instruction; a new instruction replaces whatever was in
+ * its entry.  Only instructions that were encoded without error, and
+ * that are not branches or jumps (whose words depend on where they
+ * are), are kept.  Looking a line up costs about a third as much as
+ * decoding it, so when few lookups hit (fewer than 1 in 8 of the last
+ * CACHE_WINDOW), the cache is set aside for the next CACHE_BACKOFF lines
+ * before it is tried again.  Each thread uses its own cache.  The cache is not
+ * used while debugging is on, so that every line's debugging messages
+ * are still printed.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _ENCODE_CACHE_H
+#define _ENCODE_CACHE_H
+
+#include <stdio.h>
+
+/* THE DATA STRUCTURES */
+
+#define CACHE_KEY_SIZE 40       /* longer instructions are not cached */
+#define CACHE_DEFAULT_ENTRIES 512     /* 52 bytes each, per thread */
+#define CACHE_WINDOW   4096     /* lookups between checks of hit rate */
+#define CACHE_BACKOFF  65536    /* lines not looked up after a poor one */
+
+typedef struct {
+        unsigned int hash;      /* hash of the key */
+        unsigned int word;      /* the instruction's machine code */
+        int    length;          /* length of the key; 0 if entry unused */
+        char   key[CACHE_KEY_SIZE];     /* normalized instruction text */
+} CacheEntry;
+
+typedef struct {
+        CacheEntry * entries;   /* NULL if the cache is not used */
+        int    numEntries;      /* a power of two */
+        long   lookups;         /* lines looked up */
+        long   hits;            /* lines found */
+        long   stores;          /* words put in the cache */
+        long   skipped;         /* lines not looked up (poor hit rate) */
+        int    windowLookups;   /* lookups and hits since the last */
+        int    windowHits;      /*   check of the hit rate */
+        int    skip;            /* lines still to skip */
+} EncodeCache;
+
+
+/* THE FUNCTIONS */
+
+void setCacheSize (int numEntries);
+        /* Postcondition: caches initialized from now on have numEntries
+         *      entries (rounded up to a power of two), or are not used
+         *      at all if numEntries is 0.
+         */
+
+void cacheInit (EncodeCache * cache);
+        /* Postcondition: cache is empty, with the number of entries set
+         *      by setCacheSize (CACHE_DEFAULT_ENTRIES by default).  If
+         *      the cache cannot be allocated, or debugging is on, the
+         *      cache is simply not used.
+         */
+
+int cacheDecode (EncodeCache * cache, char * inst, int lineNum, int PC,
+                 LabelTableArrayList * table, InstrFields * fields,
+                 unsigned int * word, LabelRef * unresolved);
+        /* Postcondition: if the instruction on the line inst is in the
+         *      cache, its machine code has been placed in word and
+         *      ASM_CACHED is returned; otherwise the line has been
+         *      decoded as by decodeLine (whose parameters and results
+         *      these are), and its word put in the cache if possible.
+         */
+
+void cacheFree (EncodeCache * cache);
+        /* Postcondition: the cache's memory has been released, and its
+         *      statistics added to those printed by cachePrintStats.
+         */
+
+void cachePrintStats (FILE * fp);
+        /* Postcondition: the lookups and hits of every cache freed so
+         *      far have been printed to fp.
+         */
+
+#endif
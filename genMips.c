@@ -0,0 +1,260 @@
+/*
+ * genMips: a seeded generator for synthetic MIPS assembly programs.
+ *
+ * The benchmark suite uses this program to produce inputs for the
+ * assembler that are much larger than the hand-written sample test
+ * file.  Every instruction it writes is one that pass2 supports, so a
+ * generated program should assemble without any error messages.  The
+ * same seed and parameters always produce the same program.
+ *
+ * USAGE:
+ *          genMips [-n lines] [-s seed] [-l labelDensity]
+ *                  [-b branchDistance] [-m mix]
+ *      where
+ *          lines           number of instruction lines to write
+ *                          (default 1000)
+ *          seed            seed for the random number generator
+ *                          (default 1)
+ *          labelDensity    fraction of lines, between 0 and 1, that
+ *                          start with a label (default 0.05)
+ *          branchDistance  maximum number of lines between a beq, bne,
+ *                          j, or jal and its target label (default 256)
+ *          mix             name of the instruction mix: alu, memory,
+ *                          control, or mixed (default mixed)
+ *
+ * OUTPUT:
+ *      The program is written to stdout, one instruction per line.
+ *      Labels are named L<line>, e.g., L42, and appear at the beginning
+ *      of the line of the instruction they label.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "same.h"
+
+/* The instruction groups that an instruction mix is built from. */
+enum { GRP_R, GRP_SHIFT, GRP_I, GRP_LUI, GRP_MEM, GRP_BRANCH, GRP_JUMP,
+       GRP_JR, NUM_GROUPS };
+
+/* An instruction mix gives the relative weight of each group. */
+typedef struct {
+        const char * name;
+        int weights[NUM_GROUPS];
+} InstrMix;
+
+static const InstrMix MIXES[] = {
+    /*             R  shift  I  lui mem branch jump jr */
+    { "alu",     { 50,  10, 35,  5,   0,    0,   0,  0 } },
+    { "memory",  { 20,   5, 15,  5,  55,    0,   0,  0 } },
+    { "control", { 25,   5, 20,  0,  10,   25,  12,  3 } },
+    { "mixed",   { 35,   5, 25,  3,  17,   10,   4,  1 } },
+};
+static const int NUM_MIXES = sizeof(MIXES) / sizeof(MIXES[0]);
+
+static const char * R_NAMES[] = { "add", "addu", "sub", "subu", "and",
+                                  "or", "nor", "slt", "sltu" };
+static const char * SHIFT_NAMES[] = { "sll", "srl" };
+static const char * I_NAMES[] = { "addi", "addiu", "slti", "sltiu",
+                                  "andi", "ori" };
+static const char * MEM_NAMES[] = { "lw", "sw" };
+static const char * BRANCH_NAMES[] = { "beq", "bne" };
+static const char * JUMP_NAMES[] = { "j", "jal" };
+
+/* Registers that generated code may use freely. */
+static const char * REGS[] = { "$zero", "$v0", "$v1", "$a0", "$a1", "$a2",
+    "$a3", "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7", "$s0",
+    "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7", "$t8", "$t9", "$sp",
+    "$ra" };
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* A small, fast, portable random number generator (xorshift64*), so
+ * that a given seed produces the same program on every platform.
+ */
+static unsigned long long rngState;
+
+static unsigned int nextRandom(void)
+{
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (unsigned int) ((rngState * 2685821657736338717ULL) >> 32);
+}
+
+static int randomBelow(int limit)
+{
+    return (int) (nextRandom() % (unsigned int) limit);
+}
+
+static const char * randomReg(void)
+{
+    return REGS[randomBelow(COUNT(REGS))];
+}
+
+static int pickGroup(const InstrMix * mix, int totalWeight)
+{
+    int group;
+    int choice = randomBelow(totalWeight);
+
+    for ( group = 0; group < NUM_GROUPS - 1; group++ )
+    {
+        if ( choice < mix->weights[group] )
+            break;
+        choice -= mix->weights[group];
+    }
+    return group;
+}
+
+/* Finds a labeled line within `distance` lines of `line`, searching
+ * outward from a random starting point.  Returns -1 if there is none.
+ */
+static int findTarget(const char * hasLabel, int numLines, int line,
+                      int distance)
+{
+    int start = line + randomBelow(2 * distance + 1) - distance;
+    int i;
+
+    for ( i = 0; i <= 2 * distance; i++ )
+    {
+        /* Alternate above and below the random starting point. */
+        int step = (i + 1) / 2;
+        int candidate = (i % 2 == 0) ? start + step : start - step;
+
+        if ( candidate >= 0 && candidate < numLines &&
+             candidate >= line - distance && candidate <= line + distance &&
+             hasLabel[candidate] )
+            return candidate;
+    }
+    return -1;
+}
+
+int main(int argc, char * argv[])
+{
+    long   numLines = 1000;
+    unsigned long long seed = 1;
+    double labelDensity = 0.05;
+    int    branchDistance = 256;
+    const char * mixName = "mixed";
+    const InstrMix * mix = NULL;
+    char * hasLabel;
+    int    totalWeight = 0;
+    long   line;
+    int    i;
+
+    /* Process command-line arguments. */
+    for ( i = 1; i + 1 < argc; i += 2 )
+    {
+        if ( strcmp(argv[i], "-n") == SAME )
+            numLines = atol(argv[i + 1]);
+        else if ( strcmp(argv[i], "-s") == SAME )
+            seed = strtoull(argv[i + 1], NULL, 10);
+        else if ( strcmp(argv[i], "-l") == SAME )
+            labelDensity = atof(argv[i + 1]);
+        else if ( strcmp(argv[i], "-b") == SAME )
+            branchDistance = atoi(argv[i + 1]);
+        else if ( strcmp(argv[i], "-m") == SAME )
+            mixName = argv[i + 1];
+        else
+            break;
+    }
+    if ( i < argc || numLines < 1 || branchDistance < 1 ||
+         labelDensity < 0.0 || labelDensity > 1.0 )
+    {
+        fprintf(stderr, "Usage:  %s [-n lines] [-s seed] [-l labelDensity] "
+                "[-b branchDistance] [-m alu|memory|control|mixed]\n",
+                argv[0]);
+        return 1;
+    }
+
+    /* Branch offsets must fit in 16 bits. */
+    if ( branchDistance > 32000 )
+        branchDistance = 32000;
+
+    for ( i = 0; i < NUM_MIXES; i++ )
+        if ( strcmp(MIXES[i].name, mixName) == SAME )
+            mix = &MIXES[i];
+    if ( mix == NULL )
+    {
+        fprintf(stderr, "Error: unknown instruction mix %s.\n", mixName);
+        return 1;
+    }
+    for ( i = 0; i < NUM_GROUPS; i++ )
+        totalWeight += mix->weights[i];
+
+    /* Decide up front which lines are labeled, so that branches can
+     * target labels both before and after themselves.  Line 0 is always
+     * labeled so that every program has at least one target.
+     */
+    if ( (hasLabel = malloc(numLines)) == NULL )
+    {
+        fprintf(stderr, "Error: cannot allocate space in memory.\n");
+        return 1;
+    }
+    rngState = seed * 0x9E3779B97F4A7C15ULL + 1;
+    for ( line = 0; line < numLines; line++ )
+        hasLabel[line] = (nextRandom() / 4294967296.0) < labelDensity;
+    hasLabel[0] = 1;
+
+    for ( line = 0; line < numLines; line++ )
+    {
+        int group = pickGroup(mix, totalWeight);
+        int target = -1;
+
+        if ( hasLabel[line] )
+            printf("L%ld:\t", line);
+        else
+            printf("\t");
+
+        if ( group == GRP_BRANCH || group == GRP_JUMP )
+        {
+            target = findTarget(hasLabel, (int) numLines, (int) line,
+                                branchDistance);
+            if ( target < 0 )
+                group = GRP_R;     /* no label in range; use an R-format */
+        }
+
+        switch ( group )
+        {
+          case GRP_R:
+            printf("%s %s, %s, %s\n", R_NAMES[randomBelow(COUNT(R_NAMES))],
+                   randomReg(), randomReg(), randomReg());
+            break;
+          case GRP_SHIFT:
+            printf("%s %s, %s, %d\n",
+                   SHIFT_NAMES[randomBelow(COUNT(SHIFT_NAMES))],
+                   randomReg(), randomReg(), randomBelow(32));
+            break;
+          case GRP_I:
+            printf("%s %s, %s, %d\n", I_NAMES[randomBelow(COUNT(I_NAMES))],
+                   randomReg(), randomReg(), randomBelow(32768));
+            break;
+          case GRP_LUI:
+            printf("lui %s, %d\n", randomReg(), randomBelow(65536));
+            break;
+          case GRP_MEM:
+            printf("%s %s, %d(%s)\n",
+                   MEM_NAMES[randomBelow(COUNT(MEM_NAMES))],
+                   randomReg(), 4 * randomBelow(1024), randomReg());
+            break;
+          case GRP_BRANCH:
+            printf("%s %s, %s, L%d\n",
+                   BRANCH_NAMES[randomBelow(COUNT(BRANCH_NAMES))],
+                   randomReg(), randomReg(), target);
+            break;
+          case GRP_JUMP:
+            printf("%s L%d\n", JUMP_NAMES[randomBelow(COUNT(JUMP_NAMES))],
+                   target);
+            break;
+          default:
+            printf("jr $ra\n");
+            break;
+        }
+    }
+
+    free(hasLabel);
+    return 0;
+}
@@ -16,6 +16,9 @@
  *                          be placed
  * Author: Alyce Brady
  * Date:   Last modified March 2020 (abstracted out from pass2.c)
+ * Modified: 10/19/2026
+ *      restOfLine no longer points past the end of a line that ends with
+ *      the instruction name (e.g., a last line "nop" with no newline).
  *
  */
 void getInstName(char * input, char ** instrName, char **restOfLine)
@@ -58,9 +61,11 @@ void getInstName(char * input, char ** instrName, char **restOfLine)
     }
 
     /* We have a valid token; turn it into a string and set
-     * tokBegin to point to the character after the end.
+     * restOfLine to point to the character after the end (or to the
+     * end itself, if the line ends with the name, so that it never
+     * points past the end of the line).
      */
+    *restOfLine = *tokEnd == '\0' ? tokEnd : tokEnd + 1;
     *tokEnd = '\0';
     *instrName = tokBegin;
-    *restOfLine = tokEnd + 1;
 }
@@ -0,0 +1,72 @@
+/*
+ * Image: functions to assemble a program into memory, to write it out,
+ * and to release it.
+ *
+ * See image.h for a description of an image.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "image.h"
+#include "program.h"
+
+int imageAssemble (Image * image, FILE * fp, LabelTableArrayList * table)
+{
+    Program program;
+    int     line, errors = 0;
+
+    memset(image, 0, sizeof(Image));
+    if ( ! programRead(&program, fp) )
+        return 0;
+    programEncode(&program, table, 0, program.numLines, 0);
+
+    for ( line = 0; line < program.numLines; line++ )
+        if ( program.status[line] == ASM_OK )
+            image->numWords++;
+        else if ( program.status[line] == ASM_ERROR )
+            errors++;
+    if ( errors > 0 )
+    {
+        printError("Error: %d error%s found; the program was not "
+                   "assembled.\n", errors, errors == 1 ? "" : "s");
+        programFree(&program);
+        return 0;
+    }
+
+    image->words = malloc((image->numWords + 1) * sizeof(unsigned int));
+    image->lineNums = malloc((image->numWords + 1) * sizeof(int));
+    if ( image->words == NULL || image->lineNums == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        programFree(&program);
+        imageFree(image);
+        return 0;
+    }
+    image->numWords = 0;
+    for ( line = 0; line < program.numLines; line++ )
+        if ( program.status[line] == ASM_OK )
+        {
+            image->words[image->numWords] = program.words[line];
+            image->lineNums[image->numWords++] = line + 1;
+        }
+
+    programFree(&program);
+    return 1;
+}
+
+void imageWrite (const Image * image)
+{
+    char output[MAX_WORD_LENGTH];
+    int  i;
+
+    for ( i = 0; i < image->numWords; i++ )
+        fwrite(output, 1, formatWord(image->words[i], output), stdout);
+}
+
+void imageFree (Image * image)
+{
+    free(image->words);
+    free(image->lineNums);
+    memset(image, 0, sizeof(Image));
+}
@@ -0,0 +1,61 @@
+/*
+ * Image: an assembled program held in memory, one word per instruction,
+ * with the source line each word came from.
+ *
+ * The first word is at address 0 and each takes 4 bytes, so the word at
+ * address a is words[a / 4].  An image is what the program-level tools
+ * (see run.c and pipelineModel.c) work on; the line numbers let them report what they find
+ * against the source.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _IMAGE_H
+#define _IMAGE_H
+
+#include <stdio.h>
+
+#include "LabelTableArrayList.h"
+
+/* THE DATA STRUCTURE */
+
+typedef struct {
+        unsigned int * words;   /* one per instruction */
+        int          * lineNums;        /* source line of each word */
+        int            numWords;
+} Image;
+
+
+/* THE FUNCTIONS */
+
+int imageAssemble (Image * image, FILE * fp, LabelTableArrayList * table);
+        /* Precondition: table holds the labels in fp (see pass1), and
+         *      only lines holding instructions take up space (see
+         *      setLineAddresses).
+         * Postcondition: image holds the words the source in fp
+         *      assembles into, unless an error was found.
+         * Returns 1 if everything went OK; 0 if the source holds an
+         *      invalid instruction or memory could not be allocated
+         *      (error messages have been printed, and image is empty).
+         */
+
+void imageWrite (const Image * image);
+        /* Postcondition: the words in image have been written to stdout
+         *      in the output format (see setOutputFormat).
+         */
+
+void imageFree (Image * image);
+        /* Postcondition: the memory used by image has been released.
+         */
+
+void modelPipeline (const Image * image, LabelTableArrayList * table,
+                    FILE * out);
+        /* Postcondition: the stalls, control penalties, and CPI the
+         *      program in image (whose labels are in table) would have
+         *      on a 5-stage pipeline have been estimated and written to
+         *      out, for each basic block and in total.
+         */
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Instruction information: a function that finds what an encoded
+ * instruction reads and writes, from its template.
+ *
+ * See instrInfo.h for a description of the information.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "instrInfo.h"
+
+void instrInfo (unsigned int word, long address, InstrInfo * info)
+{
+    const InstrTemplate * template = decodeTemplate(word);
+    unsigned int          opcode = word >> 26, funct = word & 0x3F;
+    int                   i;
+
+    info->template = template;
+    info->reads = info->writes = 0;
+    info->flags = 0;
+    info->target = -1;
+    if ( template == NULL )
+    {
+        info->flags = INFO_BARRIER;
+        return;
+    }
+
+    if ( opcode >= 32 && opcode < 40 )
+        info->flags = INFO_LOAD;
+    else if ( opcode >= 40 )
+        info->flags = INFO_STORE;
+    else if ( opcode == 1 || (opcode >= 4 && opcode <= 7) )
+    {
+        info->flags = INFO_BRANCH;
+        info->target = address + 4 + 4L * (short) (word & 0xFFFF);
+    }
+    else if ( opcode == 2 || opcode == 3 )
+    {
+        info->flags = INFO_JUMP | (opcode == 3 ? INFO_CALL : 0);
+        info->target = ((address + 4) & 0xF0000000L) |
+                       (long) (word & 0x3FFFFFF) << 2;
+    }
+    else if ( opcode == 0 && (funct == 8 || funct == 9) )
+        info->flags = INFO_JUMP | INFO_INDIRECT |
+                      (funct == 9 ? INFO_CALL : 0);
+    else if ( opcode == 0 && funct == 12 )
+        info->flags = INFO_BARRIER;
+
+    /* Register operands: rd is written; rt is written by an I format
+     * instruction that is not a store or a branch; the rest are read.
+     */
+    for ( i = 0; i < template->numOperands; i++ )
+    {
+        const OperandSlot * slot = &template->slots[i];
+        int                 reg;
+
+        if ( slot->kind != OPND_REG )
+            continue;
+        reg = (int) fieldValue(slot, word);
+        if ( slot->shift == 11 ||
+             (slot->shift == 16 && opcode >= 8 && opcode < 40) )
+            info->writes |= REG_BIT(reg);
+        else
+            info->reads |= REG_BIT(reg);
+    }
+
+    /* Registers no operand names. */
+    if ( info->flags & INFO_CALL )
+        info->writes |= REG_BIT(opcode == 3 ? 31 : (word >> 11) & 0x1F);
+    if ( opcode == 0 )
+        switch ( funct )
+        {
+            case 16: info->reads |= REG_BIT(REG_HI);  break;   /* mfhi */
+            case 17: info->writes |= REG_BIT(REG_HI); break;   /* mthi */
+            case 18: info->reads |= REG_BIT(REG_LO);  break;   /* mflo */
+            case 19: info->writes |= REG_BIT(REG_LO); break;   /* mtlo */
+            case 24: case 25: case 26: case 27:                /* mult, div */
+                info->writes |= REG_BIT(REG_HI) | REG_BIT(REG_LO);
+                break;
+        }
+    info->reads &= ~REG_BIT(0);
+    info->writes &= ~REG_BIT(0);
+}
@@ -0,0 +1,52 @@
+/*
+ * Instruction information: what an encoded instruction reads, writes,
+ * and does to the flow of control, as the program-level tools (the
+ * pipeline model, the schedulers) need to know it.
+ *
+ * Registers are bits in a mask: bit r for register r, plus REG_HI and
+ * REG_LO for the registers mult and div write.  $zero is never written.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _INSTR_INFO_H
+#define _INSTR_INFO_H
+
+#include "instrTable.h"
+
+/* THE DATA STRUCTURE */
+
+#define REG_HI  32
+#define REG_LO  33
+#define REG_BIT(r)  (1ULL << (r))
+
+/* Kinds of instruction, as flags. */
+#define INFO_LOAD      0x01     /* lw, lb, ... */
+#define INFO_STORE     0x02     /* sw, sb, ... */
+#define INFO_BRANCH    0x04     /* conditional: beq, bne, bltz, ... */
+#define INFO_JUMP      0x08     /* unconditional: j, jal, jr, jalr */
+#define INFO_INDIRECT  0x10     /* jr, jalr: the target is in a register */
+#define INFO_CALL      0x20     /* jal, jalr */
+#define INFO_BARRIER   0x40     /* syscall: nothing moves across it */
+
+typedef struct {
+        const InstrTemplate * template; /* NULL if not supported */
+        unsigned long long reads;       /* registers read */
+        unsigned long long writes;      /* registers written */
+        int    flags;           /* INFO_LOAD, ... */
+        long   target;          /* address a branch or direct jump goes
+                                   to; -1 for any other instruction */
+} InstrInfo;
+
+
+/* THE FUNCTIONS */
+
+void instrInfo (unsigned int word, long address, InstrInfo * info);
+        /* Postcondition: info describes the instruction encoded in word,
+         *      at address.  An unsupported word reads and writes nothing
+         *      and is a barrier.
+         */
+
+#endif
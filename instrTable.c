@@ -0,0 +1,248 @@
+/*
+ * Instruction table: the encoding template of every supported MIPS
+ * instruction, and functions to look templates up (by name, to encode,
+ * or by word, to decode) and to place operand values in their fields.
+ *
+ * See instrTable.h for a description of a template.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "instrTable.h"
+#include <pthread.h>
+
+/* Base words. */
+#define OP(opcode)          ((unsigned) (opcode) << 26)
+#define FUNCT(funct)        ((unsigned) (funct))
+#define REGIMM(rt)          (OP(1) | (unsigned) (rt) << 16)
+#define RD_IS(rd)           ((unsigned) (rd) << 11)
+
+/* Operand slots. */
+#define RS      { OPND_REG,     21,  5, 0 }
+#define RT      { OPND_REG,     16,  5, 0 }
+#define RD      { OPND_REG,     11,  5, 0 }
+#define SHAMT   { OPND_IMM,      6,  5, 0 }
+#define SIMM    { OPND_IMM,      0, 16, 1 }     /* sign-extended */
+#define UIMM    { OPND_IMM,      0, 16, 0 }     /* zero-extended */
+#define OFFSET  { OPND_BRANCH,   0, 16, 1 }
+#define TARGET  { OPND_JUMP,     0, 26, 0 }
+
+static const InstrTemplate TABLE[] =
+{
+        /* R format (opcode 0), by funct code. */
+        { "nop",     0,                  0, { { 0, 0, 0, 0 } } },
+        { "sll",     FUNCT(0),           3, { RD, RT, SHAMT } },
+        { "srl",     FUNCT(2),           3, { RD, RT, SHAMT } },
+        { "sra",     FUNCT(3),           3, { RD, RT, SHAMT } },
+        { "sllv",    FUNCT(4),           3, { RD, RT, RS } },
+        { "srlv",    FUNCT(6),           3, { RD, RT, RS } },
+        { "srav",    FUNCT(7),           3, { RD, RT, RS } },
+        { "jr",      FUNCT(8),           1, { RS } },
+        { "jalr",    FUNCT(9) | RD_IS(31), 1, { RS } },
+        { "syscall", FUNCT(12),          0, { { 0, 0, 0, 0 } } },
+        { "mfhi",    FUNCT(16),          1, { RD } },
+        { "mthi",    FUNCT(17),          1, { RS } },
+        { "mflo",    FUNCT(18),          1, { RD } },
+        { "mtlo",    FUNCT(19),          1, { RS } },
+        { "mult",    FUNCT(24),          2, { RS, RT } },
+        { "multu",   FUNCT(25),          2, { RS, RT } },
+        { "div",     FUNCT(26),          2, { RS, RT } },
+        { "divu",    FUNCT(27),          2, { RS, RT } },
+        { "add",     FUNCT(32),          3, { RD, RS, RT } },
+        { "addu",    FUNCT(33),          3, { RD, RS, RT } },
+        { "sub",     FUNCT(34),          3, { RD, RS, RT } },
+        { "subu",    FUNCT(35),          3, { RD, RS, RT } },
+        { "and",     FUNCT(36),          3, { RD, RS, RT } },
+        { "or",      FUNCT(37),          3, { RD, RS, RT } },
+        { "xor",     FUNCT(38),          3, { RD, RS, RT } },
+        { "nor",     FUNCT(39),          3, { RD, RS, RT } },
+        { "slt",     FUNCT(42),          3, { RD, RS, RT } },
+        { "sltu",    FUNCT(43),          3, { RD, RS, RT } },
+
+        /* Branches on the sign of a register (opcode 1, by rt). */
+        { "bltz",    REGIMM(0),          2, { RS, OFFSET } },
+        { "bgez",    REGIMM(1),          2, { RS, OFFSET } },
+
+        /* J format. */
+        { "j",       OP(2),              1, { TARGET } },
+        { "jal",     OP(3),              1, { TARGET } },
+
+        /* I format. */
+        { "beq",     OP(4),              3, { RS, RT, OFFSET } },
+        { "bne",     OP(5),              3, { RS, RT, OFFSET } },
+        { "blez",    OP(6),              2, { RS, OFFSET } },
+        { "bgtz",    OP(7),              2, { RS, OFFSET } },
+        { "addi",    OP(8),              3, { RT, RS, SIMM } },
+        { "addiu",   OP(9),              3, { RT, RS, SIMM } },
+        { "slti",    OP(10),             3, { RT, RS, SIMM } },
+        { "sltiu",   OP(11),             3, { RT, RS, SIMM } },
+        { "andi",    OP(12),             3, { RT, RS, UIMM } },
+        { "ori",     OP(13),             3, { RT, RS, UIMM } },
+        { "xori",    OP(14),             3, { RT, RS, UIMM } },
+        { "lui",     OP(15),             2, { RT, UIMM } },
+        { "lb",      OP(32),             3, { RT, SIMM, RS } },
+        { "lh",      OP(33),             3, { RT, SIMM, RS } },
+        { "lw",      OP(35),             3, { RT, SIMM, RS } },
+        { "lbu",     OP(36),             3, { RT, SIMM, RS } },
+        { "lhu",     OP(37),             3, { RT, SIMM, RS } },
+        { "sb",      OP(40),             3, { RT, SIMM, RS } },
+        { "sh",      OP(41),             3, { RT, SIMM, RS } },
+        { "sw",      OP(43),             3, { RT, SIMM, RS } },
+};
+
+#define TABLE_SIZE ((int) (sizeof(TABLE) / sizeof(TABLE[0])))
+
+/* The table is indexed by a hash of each name, built the first time an
+ * instruction is looked up: each bucket holds a row number plus one, or
+ * 0 if it is empty.  Collisions go to the next bucket.
+ */
+#define INDEX_SIZE 256          /* power of two, well above TABLE_SIZE */
+
+static unsigned char    tableIndex[INDEX_SIZE];
+static pthread_once_t   indexBuilt = PTHREAD_ONCE_INIT;
+
+static unsigned int nameHash(const char * name)
+{
+    unsigned int hash = 0;
+
+    while ( *name != '\0' )
+        hash = hash * 31 + (unsigned char) *name++;
+    return hash & (INDEX_SIZE - 1);
+}
+
+static void buildIndex(void)
+{
+    int i;
+
+    for ( i = 0; i < TABLE_SIZE; i++ )
+    {
+        unsigned int bucket = nameHash(TABLE[i].name);
+
+        while ( tableIndex[bucket] != 0 )
+            bucket = (bucket + 1) & (INDEX_SIZE - 1);
+        tableIndex[bucket] = (unsigned char) (i + 1);
+    }
+}
+
+const InstrTemplate * findTemplate (const char * instrName)
+{
+    unsigned int bucket = nameHash(instrName);
+
+    pthread_once(&indexBuilt, buildIndex);
+    for ( ; tableIndex[bucket] != 0; bucket = (bucket + 1) & (INDEX_SIZE - 1) )
+    {
+        const InstrTemplate * template = &TABLE[tableIndex[bucket] - 1];
+
+        if ( strcmp(template->name, instrName) == SAME )
+            return template;
+    }
+    return NULL;
+}
+
+/* For decoding, the table is also indexed by opcode; the R format
+ * instructions (opcode 0) by funct code, and the branches sharing opcode
+ * 1 by rt.  Each entry holds a row number plus one, or 0 if no
+ * instruction has that code.  Where two rows share a code (nop and sll),
+ * the one with more operands is kept, since it decodes every word with
+ * that code.
+ */
+static unsigned char    opcodeIndex[64];
+static unsigned char    functIndex[64];
+static unsigned char    regimmIndex[32];
+static unsigned int     fixedMasks[TABLE_SIZE]; /* bits not in operands */
+static pthread_once_t   decodeBuilt = PTHREAD_ONCE_INIT;
+
+static void addDecodeEntry(unsigned char * entry, int row)
+{
+    if ( *entry == 0 ||
+         TABLE[row].numOperands > TABLE[*entry - 1].numOperands )
+        *entry = (unsigned char) (row + 1);
+}
+
+static void buildDecodeIndex(void)
+{
+    int i, j;
+
+    for ( i = 0; i < TABLE_SIZE; i++ )
+    {
+        unsigned int base = TABLE[i].base;
+
+        fixedMasks[i] = 0xFFFFFFFF;
+        for ( j = 0; j < TABLE[i].numOperands; j++ )
+            fixedMasks[i] &= ~(((1U << TABLE[i].slots[j].width) - 1) <<
+                               TABLE[i].slots[j].shift);
+        if ( base >> 26 == 0 )
+            addDecodeEntry(&functIndex[base & 0x3F], i);
+        else if ( base >> 26 == 1 )
+            addDecodeEntry(&regimmIndex[(base >> 16) & 0x1F], i);
+        else
+            addDecodeEntry(&opcodeIndex[base >> 26], i);
+    }
+}
+
+const InstrTemplate * decodeTemplate (unsigned int word)
+{
+    unsigned int opcode = word >> 26;
+    int          row;
+
+    pthread_once(&decodeBuilt, buildDecodeIndex);
+    if ( opcode == 0 )
+        row = functIndex[word & 0x3F] - 1;
+    else if ( opcode == 1 )
+        row = regimmIndex[(word >> 16) & 0x1F] - 1;
+    else
+        row = opcodeIndex[opcode] - 1;
+
+    /* The bits that are not operands must be those of the template. */
+    if ( row < 0 || (word & fixedMasks[row]) != TABLE[row].base )
+        return NULL;
+    return &TABLE[row];
+}
+
+void fieldsFromBase (InstrFields * fields, unsigned int base)
+{
+    fields->opcode = base >> 26;
+    fields->rs = (base >> 21) & 0x1F;
+    fields->rt = (base >> 16) & 0x1F;
+    fields->rd = (base >> 11) & 0x1F;
+    fields->shamt = (base >> 6) & 0x1F;
+    fields->funct = base & 0x3F;
+    fields->imm = 0;
+}
+
+int isBranchOrJump (const InstrFields * fields)
+{
+    return fields->opcode >= 1 && fields->opcode <= 7;
+}
+
+
+/* Returns the opcode of the instruction named instrName (0 for an R
+ * format instruction), or -1 if it is not a valid instruction.
+ */
+int getOpCode(char * instrName)
+{
+    const InstrTemplate * template = findTemplate(instrName);
+
+    if ( template == NULL )
+    {
+        printDebug("This is an invaid opcode: %s \n", instrName);
+        return -1;
+    }
+    return (int) (template->base >> 26);
+}
+
+/* Returns the funct code of the R format instruction named instrName,
+ * or -1 if it is not a valid R format instruction.
+ */
+int getFunctCode(char * instrName)
+{
+    const InstrTemplate * template = findTemplate(instrName);
+
+    if ( template == NULL || template->base >> 26 != 0 )
+    {
+        printDebug("This is an invaid functcode: %s \n", instrName);
+        return -1;
+    }
+    return (int) (template->base & 0x3F);
+}
@@ -0,0 +1,127 @@
+/*
+ * Instruction table: an encoding template for every supported MIPS
+ * instruction.
+ *
+ * Everything about an instruction's encoding except its operands is
+ * constant: its opcode, its funct code, and any fields it does not use
+ * or fixes (the shamt of add, the rd of jr, the rt of bgez, which
+ * selects among the branches sharing opcode 1).  A template holds all of
+ * those in a precomputed base word, plus one slot per operand telling
+ * what kind of operand it is and where its value goes:
+ *
+ *      word = base | (operand 0 << shift 0) | (operand 1 << shift 1) ...
+ *
+ * where each operand is checked to fit in its slot's width (as a signed
+ * or unsigned value) and masked to it.  Operand slots are listed in the
+ * order the operands are written, e.g., for "lw $t0, 4($sp)" they are
+ * rt, the offset, and rs.
+ *
+ * The same templates decode words: a word's opcode (and, for opcodes 0
+ * and 1, its funct code or rt) selects the template, and each operand
+ * is taken back out of its slot.
+ *
+ * Adding an instruction only needs a new row in the table in
+ * instrTable.c.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _INSTR_TABLE_H
+#define _INSTR_TABLE_H
+
+#include "packFields.h"
+
+/* THE DATA STRUCTURES */
+
+/* Kinds of operand. */
+#define OPND_REG     0          /* register name, e.g., $t0 */
+#define OPND_IMM     1          /* integer constant */
+#define OPND_BRANCH  2          /* label (or constant number of words),
+                                   relative to the following instruction */
+#define OPND_JUMP    3          /* label (or constant word address) */
+
+#define MAX_OPERANDS 3
+
+/* Where one operand goes in the instruction. */
+typedef struct {
+        unsigned char kind;     /* OPND_REG, OPND_IMM, ... */
+        unsigned char shift;    /* bit position of the field */
+        unsigned char width;    /* bits in the field */
+        unsigned char isSigned; /* the value may be negative */
+} OperandSlot;
+
+typedef struct {
+        const char * name;      /* e.g., "add" */
+        unsigned int base;      /* the word with every operand 0 */
+        int          numOperands;
+        OperandSlot  slots[MAX_OPERANDS];       /* one per operand */
+} InstrTemplate;
+
+
+/* THE FUNCTIONS */
+
+const InstrTemplate * findTemplate (const char * instrName);
+        /* Returns the template for the instruction named instrName, or
+         *      NULL if there is no such instruction.
+         */
+
+const InstrTemplate * decodeTemplate (unsigned int word);
+        /* Returns the template of the instruction encoded in word, or
+         *      NULL if word is not a supported instruction.
+         */
+
+/* fieldFits and placeField are called for every operand, so they are
+ * defined here, to be inlined.
+ */
+static inline int fieldFits (const OperandSlot * slot, long value)
+        /* Returns 1 if value can be stored in slot's field; 0 if not.
+         */
+{
+        long limit = 1L << slot->width;
+
+        if ( slot->isSigned )
+            return value >= -limit / 2 && value < limit / 2;
+        return value >= 0 && value < limit;
+}
+
+static inline void placeField (InstrFields * fields,
+                               const OperandSlot * slot, unsigned int value)
+        /* Postcondition: value, masked to the width of slot's field, has
+         *      been added to the field of fields at the slot's position.
+         */
+{
+        value &= (1U << slot->width) - 1;
+        switch ( slot->shift )
+        {
+            case 21: fields->rs |= value;    break;
+            case 16: fields->rt |= value;    break;
+            case 11: fields->rd |= value;    break;
+            case  6: fields->shamt |= value; break;
+            default: fields->imm |= value << slot->shift;
+        }
+}
+
+static inline long fieldValue (const OperandSlot * slot, unsigned int word)
+        /* Returns the value of slot's field in word (sign-extended if
+         *      the slot's value may be negative).
+         */
+{
+        unsigned int value = (word >> slot->shift) &
+                             ((1U << slot->width) - 1);
+
+        if ( slot->isSigned && value >> (slot->width - 1) )
+            return (long) value - (1L << slot->width);
+        return (long) value;
+}
+
+void fieldsFromBase (InstrFields * fields, unsigned int base);
+        /* Postcondition: fields holds the fields of the word base (in R
+         *      format, so that packFields(fields) is base).
+         */
+
+int isBranchOrJump (const InstrFields * fields);
+        /* Returns 1 if the instruction's word depends on its address or
+         *      on a label's (a branch or a jump); 0 otherwise.
+         */
+
+#endif
@@ -0,0 +1,274 @@
+/**
+ * int linkObjects (int numObjects, char * names[], int numThreads,
+ *                  int printStats)
+ *
+ * This function links relocatable units (see objectFile.h) into one
+ * program, written to stdout.  The units are laid out one after another
+ * in the order given, the first at address 0.  The work is done in
+ * phases, each split among the threads:
+ *
+ *      1. each thread maps some of the object files into memory (see
+ *         objectRead), which takes no parsing;
+ *      2. the units' addresses are found (one addition per unit);
+ *      3. the global labels of every unit are merged into one table,
+ *         which is split into as many partitions as there are threads
+ *         by the hash of each label, so that each thread fills in its
+ *         own partition (taking the units in order, so a label defined
+ *         twice is always reported for the same unit);
+ *      4. each thread takes some of the units, looks up each of their
+ *         external labels once, copies their words into the program,
+ *         and patches their relocations.
+ *
+ * Apart from copying the words, the time taken is proportional to the
+ * number of global labels and relocations, not to the size of the
+ * units' source.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "objectFile.h"
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <unistd.h>
+
+#define MAX_THREADS 64
+
+/* Everything the threads share. */
+typedef struct {
+        char      ** names;     /* the object files */
+        ObjectUnit * units;
+        int        * bases;     /* address of each unit */
+        int          numUnits;
+        LabelTableArrayList partitions[MAX_THREADS];   /* global labels */
+        int          numPartitions;
+        unsigned int * program; /* the linked words */
+        atomic_int   next;      /* next unit (or partition) to work on */
+        atomic_int   errors;
+} Link;
+
+/* Runs work(link, i) for i = 0 .. count - 1, spread over numThreads
+ * threads (this one included), each taking the next i that is left.
+ */
+typedef struct {
+        Link * link;
+        int    count;
+        void (*work)(Link * link, int i);
+} Job;
+
+static void * runJob(void * arg)
+{
+    Job * job = arg;
+    int   i;
+
+    while ( (i = atomic_fetch_add(&job->link->next, 1)) < job->count )
+        job->work(job->link, i);
+    return NULL;
+}
+
+static void runInParallel(Link * link, void (*work)(Link * link, int i),
+                          int count, int numThreads)
+{
+    pthread_t threads[MAX_THREADS];
+    int       started[MAX_THREADS];
+    Job       job;
+    int       i;
+
+    job.link = link;
+    job.count = count;
+    job.work = work;
+    atomic_store(&link->next, 0);
+    if ( numThreads > count )
+        numThreads = count;
+    holdErrorExit();
+    for ( i = 1; i < numThreads; i++ )
+        started[i] = pthread_create(&threads[i], NULL, runJob, &job) == 0;
+    runJob(&job);
+    for ( i = 1; i < numThreads; i++ )
+        if ( started[i] )
+            pthread_join(threads[i], NULL);
+    releaseErrorExit();
+}
+
+static void readUnit(Link * link, int i)
+{
+    if ( ! objectRead(&link->units[i], link->names[i]) )
+        atomic_fetch_add(&link->errors, 1);
+}
+
+/* Adds the global labels whose hashes fall in partition p to it. */
+static void mergePartition(Link * link, int p)
+{
+    LabelTableArrayList * partition = &link->partitions[p];
+    int u, i;
+
+    tableInit(partition);
+    for ( u = 0; u < link->numUnits; u++ )
+    {
+        LabelTableArrayList * globals = &link->units[u].globals;
+
+        for ( i = 0; i < globals->nbrLabels; i++ )
+        {
+            char * label;
+
+            if ( globals->hashes[i] % link->numPartitions != (unsigned) p )
+                continue;
+            label = (char *) tableLabelName(globals, i);
+            if ( findLabelIndex(partition, label) != -1 )
+            {
+                printError("Error: global label %s is defined again in "
+                           "%s.\n", label, link->units[u].name);
+                atomic_fetch_add(&link->errors, 1);
+            }
+            else if ( ! addLabel(partition, label,
+                                 link->bases[u] + globals->addresses[i]) )
+                atomic_fetch_add(&link->errors, 1);
+        }
+    }
+}
+
+/* Copies unit u into the program and patches its relocations. */
+static void relocateUnit(Link * link, int u)
+{
+    ObjectUnit   * unit = &link->units[u];
+    unsigned int * words = link->program + link->bases[u] / 4;
+    int          * targets;     /* address of each external label */
+    int            i;
+
+    memcpy(words, unit->words, unit->numWords * sizeof(unsigned int));
+
+    /* Look each external label up once. */
+    targets = malloc((unit->externals.nbrLabels + 1) * sizeof(int));
+    if ( targets == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        atomic_fetch_add(&link->errors, 1);
+        return;
+    }
+    for ( i = 0; i < unit->externals.nbrLabels; i++ )
+    {
+        char * label = (char *) tableLabelName(&unit->externals, i);
+        int    p = unit->externals.hashes[i] % link->numPartitions;
+
+        targets[i] = findLabelAddr(&link->partitions[p], label);
+        if ( targets[i] == -1 )
+        {
+            printError("Error: %s refers to label %s, which no unit "
+                       "defines as global.\n", unit->name, label);
+            atomic_fetch_add(&link->errors, 1);
+        }
+    }
+
+    for ( i = 0; i < unit->numRelocs; i++ )
+    {
+        const Relocation * reloc = &unit->relocs[i];
+        unsigned int     * word = &words[reloc->word];
+        LabelRef           ref;
+
+        if ( reloc->kind == RELOC_LOCAL )
+        {
+            *word = (*word & ~0x3FFFFFFu) |
+                    ((*word + link->bases[u] / 4) & 0x3FFFFFF);
+            continue;
+        }
+        if ( targets[reloc->external] == -1 )
+            continue;           /* already reported */
+        ref.kind = reloc->kind;
+        ref.label = NULL;
+        ref.PC = link->bases[u] + 4 * (reloc->word + 1);
+        ref.lineNum = reloc->lineNum;
+        if ( ! patchLabelRef(word, &ref, targets[reloc->external]) )
+        {
+            printError("Error: %s line %d: branch target %s is too far "
+                       "away.\n", unit->name, reloc->lineNum,
+                       tableLabelName(&unit->externals, reloc->external));
+            atomic_fetch_add(&link->errors, 1);
+        }
+    }
+    free(targets);
+}
+
+int linkObjects (int numObjects, char * names[], int numThreads,
+                 int printStats)
+{
+    Link   link;
+    char   output[MAX_WORD_LENGTH];
+    long   numWords = 0, numRelocs = 0, numGlobals = 0;
+    int    i, ok = 0;
+
+    if ( numObjects < 1 )
+    {
+        printError("Error: no object files to link.\n");
+        return 0;
+    }
+    if ( numThreads <= 0 )
+        numThreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    if ( numThreads > MAX_THREADS )
+        numThreads = MAX_THREADS;
+    if ( numThreads < 1 )
+        numThreads = 1;
+
+    memset(&link, 0, sizeof(link));
+    link.names = names;
+    link.numUnits = numObjects;
+    link.numPartitions = numThreads;
+    link.units = calloc(numObjects, sizeof(ObjectUnit));
+    link.bases = malloc(numObjects * sizeof(int));
+    if ( link.units == NULL || link.bases == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(link.units);
+        free(link.bases);
+        return 0;
+    }
+
+    /* Phase 1: read the units. */
+    runInParallel(&link, readUnit, numObjects, numThreads);
+
+    /* Phase 2: lay them out. */
+    for ( i = 0; i < numObjects && atomic_load(&link.errors) == 0; i++ )
+    {
+        link.bases[i] = (int) (4 * numWords);
+        numWords += link.units[i].numWords;
+        numRelocs += link.units[i].numRelocs;
+        numGlobals += link.units[i].globals.nbrLabels;
+    }
+    if ( atomic_load(&link.errors) == 0 &&
+         (link.program = malloc((numWords + 1) * sizeof(unsigned int)))
+             == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        atomic_fetch_add(&link.errors, 1);
+    }
+
+    /* Phases 3 and 4: merge the global labels, then relocate. */
+    if ( atomic_load(&link.errors) == 0 )
+    {
+        runInParallel(&link, mergePartition, link.numPartitions,
+                      numThreads);
+        if ( atomic_load(&link.errors) == 0 )
+            runInParallel(&link, relocateUnit, numObjects, numThreads);
+        for ( i = 0; i < link.numPartitions; i++ )
+            tableFree(&link.partitions[i]);
+    }
+
+    if ( atomic_load(&link.errors) == 0 )
+    {
+        for ( i = 0; i < numWords; i++ )
+            fwrite(output, 1, formatWord(link.program[i], output), stdout);
+        ok = 1;
+    }
+    if ( printStats )
+        fprintf(stderr, "link: %d units, %ld words, %ld global labels, "
+                "%ld relocations, %d threads; %s\n", numObjects, numWords,
+                numGlobals, numRelocs, numThreads,
+                ok ? "linked" : "not linked");
+
+    for ( i = 0; i < numObjects; i++ )
+        objectFree(&link.units[i]);
+    free(link.units);
+    free(link.bases);
+    free(link.program);
+    return ok;
+}
@@ -0,0 +1,272 @@
+/**
+ * int pass2Mapped (FILE * fp, LabelTableArrayList * table, int fd,
+ *                  int numThreads)
+ *      @param  fp  pointer to an open file (stdin or other file pointer)
+ *                  from which to read lines of assembly source code
+ *      @param  table  a pointer to an existing Label Table
+ *      @param  fd  the output file, opened by openOutputFile (it is
+ *                  closed before this function returns), or -1 to
+ *                  write the output to stdout, in order
+ *      @param  numThreads  number of threads to use (0 to use one per
+ *                  processor)
+ *      @return 1 if the output was written; 0 if the input could not be
+ *              read into memory (nothing has been written, and fd is
+ *              still open)
+ *
+ * This function does the same work as pass2, but writes the output
+ * straight into the output file, which is mapped into memory, using
+ * several threads.  Every instruction has a fixed-width encoding in each
+ * output format, so once the number of instructions before a given
+ * line is known, so is the place in the file where that line's output
+ * belongs.  The work is done in phases, each split among the threads by
+ * ranges of lines:
+ *
+ *      0. each thread finds how many bytes its lines take up, so that
+ *         the address of each range's first line is known (unless every
+ *         line takes up 4 bytes; see setLineAddresses);
+ *      1. each thread encodes its lines and counts its instructions;
+ *      2. the output file is sized to hold every instruction, and each
+ *         thread formats its instructions directly into their place in
+ *         the mapped file.
+ *
+ * Nothing is merged or copied through stdio.  The output is identical to
+ * pass2's; error messages may be printed in a different order, since
+ * the threads print them as they find them.
+ *
+ * With no output file (fd is -1), the encoded program is written to
+ * stdout in order; only the encoding is done in parallel.  This is the
+ * assembler's in-memory path when --max-memory allows it.
+ *
+ * The output must be a regular file to be mapped; openOutputFile sends
+ * output to anything else (such as a pipe) through stdout instead, to be
+ * written by pass2.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "program.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define MAX_THREADS      64
+#define MIN_THREAD_LINES 4096   /* fewer lines are not worth a thread */
+
+/* The part of the work one thread does. */
+typedef struct {
+        Program * program;
+        LabelTableArrayList * table;
+        int    first, last;     /* the thread's lines: [first, last) */
+        int    address;         /* address of the first line (after
+                                   phase 0, the bytes the lines take up) */
+        long   numWords;        /* instructions in those lines */
+        char * output;          /* where the first of them is written */
+} Chunk;
+
+static void * sizeChunk(void * arg)
+{
+    Chunk * chunk = arg;
+
+    chunk->address = programAddress(chunk->program, chunk->first,
+                                    chunk->last);
+    return NULL;
+}
+
+static void * encodeChunk(void * arg)
+{
+    Chunk * chunk = arg;
+    int     line;
+
+    programEncode(chunk->program, chunk->table, chunk->first, chunk->last,
+                  chunk->address);
+
+    chunk->numWords = 0;
+    for ( line = chunk->first; line < chunk->last; line++ )
+        if ( chunk->program->status[line] == ASM_OK )
+            chunk->numWords++;
+    return NULL;
+}
+
+static void * writeChunk(void * arg)
+{
+    Chunk * chunk = arg;
+    char  * output = chunk->output;
+    int     line;
+
+    for ( line = chunk->first; line < chunk->last; line++ )
+        if ( chunk->program->status[line] == ASM_OK )
+            output += formatWord(chunk->program->words[line], output);
+    return NULL;
+}
+
+/* Runs work on every chunk, each in its own thread (the first in this
+ * thread).  A chunk whose thread cannot be started is done in this
+ * thread instead.  Reaching the error limit only ends the program once
+ * every thread has been joined (see holdErrorExit).
+ */
+static void runChunks(void * (*work)(void *), Chunk * chunks, int numChunks)
+{
+    pthread_t threads[MAX_THREADS];
+    int       started[MAX_THREADS];
+    int       i;
+
+    holdErrorExit();
+    for ( i = 1; i < numChunks; i++ )
+        started[i] = pthread_create(&threads[i], NULL, work,
+                                    &chunks[i]) == 0;
+    work(&chunks[0]);
+    for ( i = 1; i < numChunks; i++ )
+    {
+        if ( started[i] )
+            pthread_join(threads[i], NULL);
+        else
+            work(&chunks[i]);
+    }
+    releaseErrorExit();
+}
+
+/* Opens (creating or truncating) the output file.
+ *    @param name     the name of the output file
+ *    @param inPlace  1 if the output may be written in place by
+ *                    pass2Mapped, 0 if it must go through stdout
+ *    @return  the file's descriptor, if inPlace is 1 and the file can be
+ *             mapped; -1 if stdout now goes to the file instead; -2 if
+ *             the file cannot be opened (an error message was printed)
+ */
+int openOutputFile (const char * name, int inPlace)
+{
+    struct stat info;
+    int         fd;
+
+    /* Mapping the file requires opening it for reading, too. */
+    fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0666);
+    if ( fd == -1 )
+        fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0666);
+    if ( fd == -1 )
+    {
+        printError("Error: cannot open output file %s.\n", name);
+        return -2;
+    }
+
+    if ( inPlace && fstat(fd, &info) == 0 && S_ISREG(info.st_mode) &&
+         (fcntl(fd, F_GETFL) & O_ACCMODE) == O_RDWR )
+        return fd;
+
+    /* Not a regular file (e.g., a pipe): write through stdout. */
+    fflush(stdout);
+    if ( dup2(fd, STDOUT_FILENO) == -1 )
+    {
+        printError("Error: cannot write to output file %s.\n", name);
+        close(fd);
+        return -2;
+    }
+    close(fd);
+    return -1;
+}
+
+int pass2Mapped (FILE * fp, LabelTableArrayList * table, int fd,
+                 int numThreads)
+{
+    Program program;
+    Chunk   chunks[MAX_THREADS];
+    int     numChunks, i;
+    long    numWords = 0;
+    size_t  size;
+    char  * map = NULL;
+
+    if ( ! programRead(&program, fp) )
+        return 0;
+
+    /* Divide the lines evenly among the threads. */
+    if ( numThreads <= 0 )
+        numThreads = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    numChunks = program.numLines / MIN_THREAD_LINES + 1;
+    if ( numChunks > numThreads )
+        numChunks = numThreads;
+    if ( numChunks > MAX_THREADS )
+        numChunks = MAX_THREADS;
+    if ( numChunks < 1 )
+        numChunks = 1;
+    for ( i = 0; i < numChunks; i++ )
+    {
+        chunks[i].program = &program;
+        chunks[i].table = table;
+        chunks[i].first = (int) ((long) program.numLines * i / numChunks);
+        chunks[i].last = (int) ((long) program.numLines * (i + 1) /
+                                numChunks);
+        chunks[i].address = 4 * chunks[i].first;
+    }
+
+    /* Phase 0: find where each chunk starts, if only instructions take
+     * up space.
+     */
+    if ( ! usesLineAddresses() )
+    {
+        int address = 0;
+
+        runChunks(sizeChunk, chunks, numChunks);
+        for ( i = 0; i < numChunks; i++ )
+        {
+            int bytes = chunks[i].address;
+
+            chunks[i].address = address;
+            address += bytes;
+        }
+    }
+
+    /* Phase 1: encode, counting each chunk's instructions. */
+    runChunks(encodeChunk, chunks, numChunks);
+    for ( i = 0; i < numChunks; i++ )
+        numWords += chunks[i].numWords;
+
+    /* Phase 2: size and map the file, and write each chunk in place. */
+    size = (size_t) numWords * outputWordLength();
+    if ( fd != -1 && size > 0 && ftruncate(fd, size) == 0 )
+        map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if ( map != NULL && map != MAP_FAILED )
+    {
+        char * output = map;
+
+        for ( i = 0; i < numChunks; i++ )
+        {
+            chunks[i].output = output;
+            output += chunks[i].numWords * outputWordLength();
+        }
+        runChunks(writeChunk, chunks, numChunks);
+        munmap(map, size);
+        close(fd);
+    }
+    else if ( size > 0 )
+    {
+        /* Writing to stdout, or cannot map the file; write in order. */
+        FILE * out = fd == -1 ? stdout : fdopen(fd, "w");
+        char   output[MAX_WORD_LENGTH];
+
+        if ( out == NULL || (fd != -1 && ftruncate(fd, 0) != 0) )
+        {
+            printError("Error: cannot write to output file.\n");
+            if ( out != NULL )
+                fclose(out);
+            else
+                close(fd);
+        }
+        else
+        {
+            for ( i = 0; i < program.numLines; i++ )
+                if ( program.status[i] == ASM_OK )
+                    fwrite(output, 1, formatWord(program.words[i], output),
+                           out);
+            if ( out != stdout )
+                fclose(out);
+        }
+    }
+    else if ( fd != -1 )
+        close(fd);
+
+    programFree(&program);
+    return 1;
+}
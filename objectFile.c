@@ -0,0 +1,274 @@
+/*
+ * Object file: functions to build relocatable units, to write them to
+ * object files, and to map object files into memory.
+ *
+ * See objectFile.h for a description of a unit and of an object file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "objectFile.h"
+#include "symbolMap.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char * ERROR = "Error: cannot allocate space in memory.\n";
+
+void objectInit (ObjectUnit * unit, const char * name)
+{
+    memset(unit, 0, sizeof(ObjectUnit));
+    unit->name = name;
+    arenaInit(&unit->arena, 0);
+    tableInitInArena(&unit->globals, &unit->arena);
+    tableInitInArena(&unit->externals, &unit->arena);
+}
+
+int objectAddWord (ObjectUnit * unit, unsigned int word)
+{
+    if ( unit->numWords == unit->maxWords )
+    {
+        int            maxWords = unit->maxWords * 2 + 1024;
+        unsigned int * words = arenaRealloc(&unit->arena, unit->words,
+                                  unit->maxWords * sizeof(unsigned int),
+                                  maxWords * sizeof(unsigned int));
+        if ( words == NULL )
+        {
+            printError("%s", ERROR);
+            return 0;
+        }
+        unit->words = words;
+        unit->maxWords = maxWords;
+    }
+    unit->words[unit->numWords++] = word;
+    return 1;
+}
+
+int objectAddReloc (ObjectUnit * unit, int kind, int word, int lineNum,
+                    const char * label)
+{
+    Relocation * reloc;
+    int          external = -1;
+
+    if ( label != NULL &&
+         (external = findLabelIndex(&unit->externals, label)) == -1 )
+    {
+        if ( ! addLabel(&unit->externals, (char *) label, 0) )
+            return 0;
+        external = unit->externals.nbrLabels - 1;
+    }
+
+    if ( unit->numRelocs == unit->maxRelocs )
+    {
+        int          maxRelocs = unit->maxRelocs * 2 + 256;
+        Relocation * relocs = arenaRealloc(&unit->arena, unit->relocs,
+                                  unit->maxRelocs * sizeof(Relocation),
+                                  maxRelocs * sizeof(Relocation));
+        if ( relocs == NULL )
+        {
+            printError("%s", ERROR);
+            return 0;
+        }
+        unit->relocs = relocs;
+        unit->maxRelocs = maxRelocs;
+    }
+    reloc = &unit->relocs[unit->numRelocs++];
+    reloc->kind = kind;
+    reloc->word = word;
+    reloc->lineNum = lineNum;
+    reloc->external = external;
+    return 1;
+}
+
+/* Sets the offset of section, which follows the one before it, and
+ * returns the offset of the next section.
+ */
+static size_t placeSection(ObjectSection * section, size_t offset)
+{
+    section->offset = (unsigned int) offset;
+    return (offset + section->size + 3) & ~(size_t) 3;
+}
+
+static void describeTable(ObjectSection * section,
+                          LabelTableArrayList * table)
+{
+    section->count = table->nbrLabels;
+    section->numSlots = table->numSlots;
+    section->poolSize = table->poolSize;
+    section->size = (unsigned int) symbolArraysSize(table->nbrLabels,
+                                      table->numSlots, table->poolSize);
+}
+
+/* Writes zeros to fp up to offset. */
+static int padTo(FILE * fp, size_t offset)
+{
+    static const char zeros[4];
+    long              at = ftell(fp);
+
+    return at >= 0 && (size_t) at <= offset &&
+           fwrite(zeros, 1, offset - at, fp) == offset - at;
+}
+
+int objectWrite (ObjectUnit * unit, const char * name)
+{
+    ObjectHeader    header;
+    ObjectSection * sections = header.sections;
+    FILE          * fp;
+    size_t          offset;
+    int             ok;
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, OBJECT_MAGIC, sizeof(header.magic));
+    header.version = OBJECT_VERSION;
+    sections[OBJECT_WORDS].count = unit->numWords;
+    sections[OBJECT_WORDS].size = unit->numWords * sizeof(unsigned int);
+    describeTable(&sections[OBJECT_GLOBALS], &unit->globals);
+    describeTable(&sections[OBJECT_EXTERNALS], &unit->externals);
+    sections[OBJECT_RELOCS].count = unit->numRelocs;
+    sections[OBJECT_RELOCS].size = unit->numRelocs * sizeof(Relocation);
+    offset = sizeof(ObjectHeader);
+    offset = placeSection(&sections[OBJECT_WORDS], offset);
+    offset = placeSection(&sections[OBJECT_GLOBALS], offset);
+    offset = placeSection(&sections[OBJECT_EXTERNALS], offset);
+    offset = placeSection(&sections[OBJECT_RELOCS], offset);
+    header.fileSize = (unsigned int) offset;
+
+    if ( (fp = fopen(name, "wb")) == NULL )
+    {
+        printError("Error: cannot open object file %s.\n", name);
+        return 0;
+    }
+    ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+         fwrite(unit->words, sizeof(unsigned int), unit->numWords, fp) ==
+             (size_t) unit->numWords &&
+         padTo(fp, sections[OBJECT_GLOBALS].offset) &&
+         symbolArraysWrite(&unit->globals, fp) &&
+         padTo(fp, sections[OBJECT_EXTERNALS].offset) &&
+         symbolArraysWrite(&unit->externals, fp) &&
+         padTo(fp, sections[OBJECT_RELOCS].offset) &&
+         fwrite(unit->relocs, sizeof(Relocation), unit->numRelocs, fp) ==
+             (size_t) unit->numRelocs &&
+         padTo(fp, header.fileSize);
+
+    if ( fclose(fp) != 0 || ! ok )
+    {
+        printError("Error: cannot write object file %s.\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+/* Returns 1 if the sections described by header lie in a file of size
+ * bytes, each on a 4-byte boundary, and the words and relocations fill
+ * their sections; 0 if not.
+ */
+static int validHeader(const ObjectHeader * header, size_t size)
+{
+    const ObjectSection * sections = header->sections;
+    int                   i;
+
+    if ( size < sizeof(ObjectHeader) ||
+         memcmp(header->magic, OBJECT_MAGIC, sizeof(header->magic))
+             != SAME ||
+         header->version != OBJECT_VERSION || header->fileSize != size )
+        return 0;
+    for ( i = 0; i < OBJECT_SECTIONS; i++ )
+        if ( sections[i].offset < sizeof(ObjectHeader) ||
+             sections[i].offset % 4 != 0 || sections[i].offset > size ||
+             sections[i].size > size - sections[i].offset )
+            return 0;
+    return sections[OBJECT_WORDS].size ==
+               (size_t) sections[OBJECT_WORDS].count * sizeof(unsigned int)
+           && sections[OBJECT_RELOCS].size ==
+               (size_t) sections[OBJECT_RELOCS].count * sizeof(Relocation)
+           && sections[OBJECT_WORDS].count <= INT_MAX / 4;
+}
+
+/* Returns 1 if every relocation is of a word in the unit, and refers to
+ * one of its external labels (unless it is local); 0 if not.
+ */
+static int validRelocs(const ObjectUnit * unit)
+{
+    int i;
+
+    for ( i = 0; i < unit->numRelocs; i++ )
+    {
+        const Relocation * reloc = &unit->relocs[i];
+
+        if ( reloc->kind < RELOC_BRANCH || reloc->kind > RELOC_LOCAL ||
+             reloc->word < 0 || reloc->word >= unit->numWords ||
+             (reloc->kind == RELOC_LOCAL) != (reloc->external == -1) ||
+             reloc->external >= unit->externals.nbrLabels )
+            return 0;
+    }
+    return 1;
+}
+
+int objectRead (ObjectUnit * unit, const char * name)
+{
+    struct stat     info;
+    ObjectHeader  * header;
+    ObjectSection * sections;
+    char          * data;
+    int             fd;
+
+    objectInit(unit, name);
+    if ( (fd = open(name, O_RDONLY)) == -1 )
+    {
+        printError("Error: cannot open object file %s.\n", name);
+        return 0;
+    }
+    if ( fstat(fd, &info) == 0 && info.st_size > 0 )
+    {
+        unit->map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if ( unit->map == MAP_FAILED )
+            unit->map = NULL;
+        else
+            unit->mapSize = info.st_size;
+    }
+    close(fd);
+
+    /* Point the unit into the map. */
+    header = unit->map;
+    data = unit->map;
+    if ( header == NULL || ! validHeader(header, unit->mapSize) )
+    {
+        printError("Error: %s is not a valid object file.\n", name);
+        return 0;
+    }
+    sections = header->sections;
+    unit->words = (unsigned int *) (data + sections[OBJECT_WORDS].offset);
+    unit->numWords = unit->maxWords = sections[OBJECT_WORDS].count;
+    unit->relocs = (Relocation *) (data + sections[OBJECT_RELOCS].offset);
+    unit->numRelocs = unit->maxRelocs = sections[OBJECT_RELOCS].count;
+    if ( ! symbolArraysMap(&unit->globals,
+                           data + sections[OBJECT_GLOBALS].offset,
+                           sections[OBJECT_GLOBALS].size,
+                           sections[OBJECT_GLOBALS].count,
+                           sections[OBJECT_GLOBALS].numSlots,
+                           sections[OBJECT_GLOBALS].poolSize) ||
+         ! symbolArraysMap(&unit->externals,
+                           data + sections[OBJECT_EXTERNALS].offset,
+                           sections[OBJECT_EXTERNALS].size,
+                           sections[OBJECT_EXTERNALS].count,
+                           sections[OBJECT_EXTERNALS].numSlots,
+                           sections[OBJECT_EXTERNALS].poolSize) ||
+         ! validRelocs(unit) )
+    {
+        printError("Error: %s is not a valid object file.\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+void objectFree (ObjectUnit * unit)
+{
+    if ( unit->map != NULL )
+        munmap(unit->map, unit->mapSize);
+    arenaFree(&unit->arena);
+    memset(unit, 0, sizeof(ObjectUnit));
+}
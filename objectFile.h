@@ -0,0 +1,172 @@
+/*
+ * Object file: a relocatable unit of assembled code, to be linked with
+ * other units into one program.
+ *
+ * A unit is assembled as though it started at address 0 (see
+ * objectPass).  It holds:
+ *      - its words, one per instruction;
+ *      - its global labels -- those named in a .globl directive -- with
+ *        their addresses in the unit;
+ *      - its external labels: every label the unit refers to but does
+ *        not define, each listed once;
+ *      - its relocations: the words that must be patched once the unit's
+ *        place in the program, and the addresses of its external
+ *        labels, are known.
+ * Branches to labels in the same unit need no relocation, since a
+ * branch offset does not depend on where the unit is; jumps to them do,
+ * since a jump target is an address.
+ *
+ * An object file is laid out so that the linker can map it into memory
+ * and use it as it is, without parsing anything: a fixed header,
+ * followed by four sections, each found by its offset from the start of
+ * the file and starting on a 4-byte boundary:
+ *
+ *      ObjectHeader            "MIPSOBJ1", version, file size, and the
+ *                              offset, size, and count of each section
+ *      words[numWords]         the encoded words
+ *      globals                 the arrays of a LabelTableArrayList --
+ *      externals               hashes, name offsets, name lengths,
+ *                              addresses, hash index, and string pool
+ *                              (see symbolMap.h) -- so that labels are
+ *                              looked up with the hashes saved in them
+ *      relocs[numRelocs]       Relocation records
+ *
+ * All numbers are in the byte order of the machine that wrote the file.
+ * The dumpObject program prints an object file as text.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _OBJECT_FILE_H
+#define _OBJECT_FILE_H
+
+#include <stdio.h>
+
+#include <stddef.h>
+
+#include "arena.h"
+#include "LabelTableArrayList.h"
+
+/* THE DATA STRUCTURES */
+
+/* Kinds of relocation. */
+#define RELOC_BRANCH  REF_BRANCH  /* 16-bit offset to an external label */
+#define RELOC_JUMP    REF_JUMP    /* 26-bit target of an external label */
+#define RELOC_LOCAL   3           /* 26-bit target of a label in the unit;
+                                     the unit's address is added to it */
+
+typedef struct {
+        int    kind;            /* RELOC_BRANCH, RELOC_JUMP, RELOC_LOCAL */
+        int    word;            /* number of the word to patch */
+        int    lineNum;         /* line in the unit (for error messages) */
+        int    external;        /* entry number of the label in the
+                                   unit's externals; -1 for RELOC_LOCAL */
+} Relocation;
+
+/* The sections of an object file, in order. */
+enum { OBJECT_WORDS, OBJECT_GLOBALS, OBJECT_EXTERNALS, OBJECT_RELOCS,
+       OBJECT_SECTIONS };
+
+#define OBJECT_MAGIC   "MIPSOBJ1"
+#define OBJECT_VERSION 1
+
+typedef struct {
+        unsigned int offset;    /* bytes from the start of the file */
+        unsigned int size;      /* bytes, not counting padding */
+        unsigned int count;     /* words, labels, or relocations */
+        unsigned int numSlots;  /* symbol sections: slots in the index */
+        unsigned int poolSize;  /* symbol sections: bytes of names */
+} ObjectSection;
+
+typedef struct {
+        char         magic[8];  /* OBJECT_MAGIC (not null-terminated) */
+        unsigned int version;   /* OBJECT_VERSION */
+        unsigned int fileSize;  /* bytes */
+        ObjectSection sections[OBJECT_SECTIONS];
+} ObjectHeader;
+
+typedef struct {
+        const char * name;      /* file name (for error messages) */
+        unsigned int * words;
+        int    numWords, maxWords;
+        LabelTableArrayList globals;    /* exported labels */
+        LabelTableArrayList externals;  /* labels defined elsewhere (the
+                                           addresses are not used) */
+        Relocation * relocs;
+        int    numRelocs, maxRelocs;
+        Arena  arena;           /* holds everything above, for a unit
+                                   being built */
+        void * map;             /* the mapped object file, for a unit
+                                   that has been read (read only) */
+        size_t mapSize;         /* bytes mapped */
+} ObjectUnit;
+
+
+/* THE FUNCTIONS */
+
+void objectInit (ObjectUnit * unit, const char * name);
+        /* Postcondition: unit is empty; name is the name of its file.
+         */
+
+int objectAddWord (ObjectUnit * unit, unsigned int word);
+        /* Postcondition: word has been added to the end of the unit.
+         * Returns 1 if everything went OK; 0 if memory allocation error.
+         */
+
+int objectAddReloc (ObjectUnit * unit, int kind, int word, int lineNum,
+                    const char * label);
+        /* Postcondition: a relocation of the given kind for word number
+         *      word has been added to the unit; label (NULL for
+         *      RELOC_LOCAL) is the external label it refers to, which
+         *      has been added to the unit's externals if necessary.
+         * Returns 1 if everything went OK; 0 if memory allocation error.
+         */
+
+int objectWrite (ObjectUnit * unit, const char * name);
+        /* Postcondition: the unit has been written to the object file
+         *      name.
+         * Returns 1 if everything went OK; 0 if an error occurred (an
+         *      error message has been printed).
+         */
+
+int objectRead (ObjectUnit * unit, const char * name);
+        /* Postcondition: the object file name has been mapped into
+         *      memory, and unit's words, labels, and relocations point
+         *      into it.  The unit must not be changed.
+         * Returns 1 if everything went OK; 0 if the file cannot be read
+         *      or is not a valid object file (an error message has been
+         *      printed).  Either way, unit must be freed with objectFree.
+         */
+
+void objectFree (ObjectUnit * unit);
+        /* Postcondition: the memory used by unit has been released.
+         */
+
+int objectPass (FILE * fp, LabelTableArrayList * table, const char * name);
+        /* Precondition: table holds the labels in fp (see pass1), and
+         *      only lines holding instructions take up space (see
+         *      setLineAddresses).
+         * Postcondition: the assembly source in fp has been assembled
+         *      into a unit and written to the object file name, unless
+         *      an error was found.
+         * Returns 1 if the object file was written; 0 if not (error
+         *      messages have been printed).
+         */
+
+int linkObjects (int numObjects, char * names[], int numThreads,
+                 int printStats);
+        /* Postcondition: the units in the object files names have been
+         *      laid out one after another, in order, starting at address
+         *      0; their relocations have been patched; and the program
+         *      has been written to stdout, in the output format chosen
+         *      with setOutputFormat.  The objects are read, and their
+         *      labels merged and relocations patched, by numThreads
+         *      threads (0 to use one per processor).  If printStats is
+         *      1, statistics about the link are printed to stderr.
+         * Returns 1 if the program was written; 0 if an error was found
+         *      (error messages have been printed and nothing written).
+         */
+
+#endif
@@ -0,0 +1,158 @@
+/**
+ * int objectPass (FILE * fp, LabelTableArrayList * table, const char * name)
+ *      @param  fp  pointer to an open file (stdin or other file pointer)
+ *                  from which to read lines of assembly source code
+ *      @param  table  a pointer to the Label Table built by pass1
+ *      @param  name  the name of the object file to write
+ *      @return 1 if the object file was written; 0 if not
+ *
+ * This function does the work of pass2 for a unit that is to be linked
+ * with others (see objectFile.h and linkObjects): rather than printing
+ * the words, it collects them in a relocatable unit and writes the unit
+ * to an object file.
+ *
+ * Every instruction is encoded as though no label were defined, so that
+ * each reference to a label is described by assembleLine rather than
+ * resolved.  A reference to a label in the unit is then completed here;
+ * if it is a jump, whose target is an address, it is also recorded as a
+ * local relocation, since the unit may not end up at address 0.  A
+ * reference to a label that is not in the unit is left for the linker,
+ * as a relocation of an external label.
+ *
+ * The labels named in .globl (or .global) directives are the unit's
+ * global labels, which other units may refer to.  Each must be defined
+ * in the unit.
+ *
+ * The object file is not written if any error is found.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "objectFile.h"
+
+/* Adds every label named in names (the rest of a .globl directive on
+ * line lineNum) to wanted, with the line number as its address.
+ */
+static void addGlobals(LabelTableArrayList * wanted, char * names,
+                       int lineNum)
+{
+    char * begin = names, * end;
+    char   separator;
+
+    for ( ;; )
+    {
+        getToken(&begin, &end);
+        if ( *begin == '\0' )
+            return;
+        separator = *end;
+        *end = '\0';
+        if ( findLabelIndex(wanted, begin) == -1 )
+            addLabel(wanted, begin, lineNum);
+        if ( separator == '\0' )
+            return;
+        begin = end + 1;
+    }
+}
+
+int objectPass (FILE * fp, LabelTableArrayList * table, const char * name)
+{
+    ObjectUnit unit;
+    LabelTableArrayList none;    /* no labels, so every reference is
+                                    described rather than resolved */
+    LabelTableArrayList wanted;  /* labels named in .globl directives */
+    char     inst[BUFSIZ];
+    char     copy[BUFSIZ + 1];   /* copy of the line, ending in newline */
+    char   * instrName, * rest;
+    int      lineNum, address = 0;
+    int      errors = 0;
+    int      i, result;
+    unsigned int word;
+    LabelRef ref;
+
+    objectInit(&unit, name);
+    tableInit(&none);
+    tableInit(&wanted);
+
+    for ( lineNum = 1; fgets(inst, BUFSIZ, fp); lineNum++ )
+    {
+        /* Note the labels named by a .globl directive.  (getInstName
+         * expects the name to be followed by something, so make sure
+         * the line ends in a newline.)
+         */
+        strcpy(copy, inst);
+        if ( strchr(copy, '\n') == NULL )
+            strcat(copy, "\n");
+        getInstName(copy, &instrName, &rest);
+        if ( instrName != NULL && (strcmp(instrName, ".globl") == SAME ||
+                                   strcmp(instrName, ".global") == SAME) )
+            addGlobals(&wanted, rest, lineNum);
+
+        result = assembleLine(inst, lineNum, address + 4, &none, &word,
+                              &ref);
+        address += addressStep(result);
+        if ( result == ASM_ERROR )
+            errors++;
+        if ( result != ASM_OK )
+            continue;
+
+        /* Complete a reference to a label in the unit now; leave one to
+         * any other label for the linker.
+         */
+        if ( ref.kind != REF_NONE )
+        {
+            int entry = findLabelIndex(table, ref.label);
+            int ok;
+
+            if ( entry == -1 )
+                ok = objectAddReloc(&unit, ref.kind, unit.numWords,
+                                    lineNum, ref.label);
+            else if ( ! patchLabelRef(&word, &ref, table->addresses[entry]) )
+            {
+                printError("Line %d: branch target %s is too far away.\n",
+                           lineNum, ref.label);
+                errors++;
+                continue;
+            }
+            else
+                ok = ref.kind != REF_JUMP ||
+                     objectAddReloc(&unit, RELOC_LOCAL, unit.numWords,
+                                    lineNum, NULL);
+            if ( ! ok )
+                break;          /* error message already printed */
+        }
+        if ( ! objectAddWord(&unit, word) )
+            break;
+    }
+
+    /* Every global label must be defined in the unit. */
+    for ( i = 0; i < wanted.nbrLabels; i++ )
+    {
+        const char * label = tableLabelName(&wanted, i);
+        int          entry = findLabelIndex(table, label);
+
+        if ( entry == -1 )
+        {
+            printError("Line %d: global label %s is not defined.\n",
+                       wanted.addresses[i], label);
+            errors++;
+        }
+        else
+            addLabel(&unit.globals, (char *) label,
+                     table->addresses[entry]);
+    }
+
+    result = 0;
+    if ( ! feof(fp) )
+        printError("Error: object file %s not written.\n", name);
+    else if ( errors > 0 )
+        printError("Error: %d error%s found; object file %s not written.\n",
+                   errors, errors == 1 ? "" : "s", name);
+    else
+        result = objectWrite(&unit, name);
+
+    tableFree(&wanted);
+    tableFree(&none);
+    objectFree(&unit);
+    return result;
+}
@@ -0,0 +1,183 @@
+/*
+ * Field packing: scalar, SSE2, and AVX2 kernels that pack decoded
+ * instruction fields into machine code words, and the run-time choice
+ * among them.  See packFields.h for the layout being packed.
+ *
+ * The SIMD kernels are compiled only for x86 with GCC or Clang; the
+ * AVX2 kernel is compiled for AVX2 with a target attribute, so the rest
+ * of the program does not require AVX2 and the kernel is only called
+ * when the processor has it.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "packFields.h"
+
+#include <stdatomic.h>
+#include <stddef.h>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define HAVE_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+typedef void (*PackKernel)(const FieldBlock * block, unsigned int * words,
+                           int first);
+
+/* Packs instructions first through block->count - 1, one at a time. */
+static void packScalar(const FieldBlock * block, unsigned int * words,
+                       int first)
+{
+    int i;
+
+    for ( i = first; i < block->count; i++ )
+        words[i] = block->opcode[i] << 26 | block->rs[i] << 21 |
+                   block->rt[i] << 16 | block->rd[i] << 11 |
+                   block->shamt[i] << 6 | block->funct[i] | block->imm[i];
+}
+
+#ifdef HAVE_X86_KERNELS
+
+/* Packs four instructions at a time, then the rest one at a time. */
+__attribute__((target("sse2")))
+static void packSse2(const FieldBlock * block, unsigned int * words,
+                     int first)
+{
+    int i;
+
+    for ( i = first; i + 4 <= block->count; i += 4 )
+    {
+#define LOAD(field) _mm_loadu_si128((const __m128i *) (block->field + i))
+        __m128i word = _mm_or_si128(
+            _mm_or_si128(_mm_slli_epi32(LOAD(opcode), 26),
+                         _mm_slli_epi32(LOAD(rs), 21)),
+            _mm_or_si128(_mm_slli_epi32(LOAD(rt), 16),
+                         _mm_slli_epi32(LOAD(rd), 11)));
+        word = _mm_or_si128(word,
+            _mm_or_si128(_mm_slli_epi32(LOAD(shamt), 6),
+                         _mm_or_si128(LOAD(funct), LOAD(imm))));
+#undef LOAD
+        _mm_storeu_si128((__m128i *) (words + i), word);
+    }
+    packScalar(block, words, i);
+}
+
+/* Packs eight instructions at a time, then the rest with SSE2. */
+__attribute__((target("avx2")))
+static void packAvx2(const FieldBlock * block, unsigned int * words,
+                     int first)
+{
+    int i;
+
+    for ( i = first; i + 8 <= block->count; i += 8 )
+    {
+#define LOAD(field) _mm256_loadu_si256((const __m256i *) (block->field + i))
+        __m256i word = _mm256_or_si256(
+            _mm256_or_si256(_mm256_slli_epi32(LOAD(opcode), 26),
+                            _mm256_slli_epi32(LOAD(rs), 21)),
+            _mm256_or_si256(_mm256_slli_epi32(LOAD(rt), 16),
+                            _mm256_slli_epi32(LOAD(rd), 11)));
+        word = _mm256_or_si256(word,
+            _mm256_or_si256(_mm256_slli_epi32(LOAD(shamt), 6),
+                            _mm256_or_si256(LOAD(funct), LOAD(imm))));
+#undef LOAD
+        _mm256_storeu_si256((__m256i *) (words + i), word);
+    }
+    packSse2(block, words, i);
+}
+
+#endif
+
+/* Returns the kernel for kernel number kernel, or NULL if it cannot be
+ * used on this processor.
+ */
+static PackKernel findKernel(int kernel)
+{
+    switch ( kernel )
+    {
+        case PACK_SCALAR:
+            return packScalar;
+#ifdef HAVE_X86_KERNELS
+        case PACK_SSE2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("sse2") ? packSse2 : NULL;
+        case PACK_AVX2:
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("avx2") ? packAvx2 : NULL;
+#endif
+        default:
+            return NULL;
+    }
+}
+
+/* The kernel packBlock uses (-1 until it is chosen, the first time it
+ * is needed).  The choice is the same every time, so threads racing to
+ * make it agree.
+ */
+static atomic_int bestKernel = -1;
+
+int packKernelInUse (void)
+{
+    int kernel = atomic_load_explicit(&bestKernel, memory_order_relaxed);
+
+    if ( kernel == -1 )
+    {
+        for ( kernel = NUM_PACK_KERNELS - 1; kernel > PACK_SCALAR; kernel-- )
+            if ( findKernel(kernel) != NULL )
+                break;
+        atomic_store_explicit(&bestKernel, kernel, memory_order_relaxed);
+    }
+    return kernel;
+}
+
+unsigned int packFields (const InstrFields * fields)
+{
+    return fields->opcode << 26 | fields->rs << 21 | fields->rt << 16 |
+           fields->rd << 11 | fields->shamt << 6 | fields->funct |
+           fields->imm;
+}
+
+void blockAdd (FieldBlock * block, const InstrFields * fields)
+{
+    int i = block->count++;
+
+    block->opcode[i] = fields->opcode;
+    block->rs[i] = fields->rs;
+    block->rt[i] = fields->rt;
+    block->rd[i] = fields->rd;
+    block->shamt[i] = fields->shamt;
+    block->funct[i] = fields->funct;
+    block->imm[i] = fields->imm;
+}
+
+void packBlock (const FieldBlock * block, unsigned int * words)
+{
+#ifdef HAVE_X86_KERNELS
+    static const PackKernel kernels[NUM_PACK_KERNELS] = { packScalar,
+                                                          packSse2,
+                                                          packAvx2 };
+#else
+    static const PackKernel kernels[NUM_PACK_KERNELS] = { packScalar };
+#endif
+
+    kernels[packKernelInUse()](block, words, 0);
+}
+
+int packBlockWith (int kernel, const FieldBlock * block,
+                   unsigned int * words)
+{
+    PackKernel pack = findKernel(kernel);
+
+    if ( pack == NULL )
+        return 0;
+    pack(block, words, 0);
+    return 1;
+}
+
+const char * packKernelName (int kernel)
+{
+    static const char * names[NUM_PACK_KERNELS] = { "scalar", "sse2",
+                                                    "avx2" };
+
+    return kernel >= 0 && kernel < NUM_PACK_KERNELS ? names[kernel] : "?";
+}
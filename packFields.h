@@ -0,0 +1,92 @@
+/*
+ * Field packing: combining the numeric fields of decoded instructions
+ * into 32-bit machine code words, one at a time or in blocks.
+ *
+ * Every MIPS instruction format is a subset of the same layout:
+ *
+ *      opcode(6) rs(5) rt(5) rd(5) shamt(5) funct(6)     R format
+ *      opcode(6) rs(5) rt(5) immediate(16)               I format
+ *      opcode(6) target(26)                              J format
+ *
+ * Fields an instruction does not use are 0, and the immediate (or jump
+ * target) is stored already masked to its width, so one formula packs
+ * every format:
+ *
+ *      opcode << 26 | rs << 21 | rt << 16 | rd << 11 | shamt << 6 |
+ *      funct | imm
+ *
+ * A block holds up to PACK_BLOCK_SIZE decoded instructions as a
+ * structure of arrays, so that the same field of consecutive
+ * instructions is contiguous in memory and can be shifted and combined
+ * 4 (SSE2) or 8 (AVX2) at a time.  The kernel used is chosen at run time
+ * from the features of the processor; the scalar kernel works anywhere.
+ * All kernels produce identical words.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _PACK_FIELDS_H
+#define _PACK_FIELDS_H
+
+/* THE DATA STRUCTURES */
+
+/* The numeric fields of one decoded instruction. */
+typedef struct {
+        unsigned int opcode, rs, rt, rd, shamt, funct;
+        unsigned int imm;       /* immediate or target, already masked */
+} InstrFields;
+
+#define PACK_BLOCK_SIZE 16
+
+/* Decoded instructions waiting to be packed, as a structure of arrays. */
+typedef struct {
+        unsigned int opcode[PACK_BLOCK_SIZE];
+        unsigned int rs[PACK_BLOCK_SIZE];
+        unsigned int rt[PACK_BLOCK_SIZE];
+        unsigned int rd[PACK_BLOCK_SIZE];
+        unsigned int shamt[PACK_BLOCK_SIZE];
+        unsigned int funct[PACK_BLOCK_SIZE];
+        unsigned int imm[PACK_BLOCK_SIZE];
+        int count;              /* number of instructions in the block */
+} FieldBlock;
+
+/* The packing kernels (see packBlockWith). */
+#define PACK_SCALAR 0
+#define PACK_SSE2   1
+#define PACK_AVX2   2
+#define NUM_PACK_KERNELS 3
+
+
+/* THE FUNCTIONS */
+
+unsigned int packFields (const InstrFields * fields);
+        /* Returns the machine code word for one decoded instruction.
+         */
+
+void blockAdd (FieldBlock * block, const InstrFields * fields);
+        /* Precondition: block->count < PACK_BLOCK_SIZE.
+         * Postcondition: fields has been added to the end of block.
+         */
+
+void packBlock (const FieldBlock * block, unsigned int * words);
+        /* Postcondition: words[0 .. block->count - 1] hold the machine
+         *      code for the instructions in block, packed by the best
+         *      kernel this processor supports.
+         */
+
+int packBlockWith (int kernel, const FieldBlock * block,
+                   unsigned int * words);
+        /* Postcondition: as for packBlock, but using the given kernel.
+         * Returns 1 if the kernel was used; 0 if this processor (or
+         *      this build) does not support it (words are unchanged).
+         */
+
+const char * packKernelName (int kernel);
+        /* Returns the name of a kernel ("scalar", "sse2", or "avx2").
+         */
+
+int packKernelInUse (void);
+        /* Returns the kernel packBlock uses on this processor.
+         */
+
+#endif
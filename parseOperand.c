@@ -0,0 +1,130 @@
+/*
+ * This file contains the parseOperand function, which classifies one
+ * operand token of an instruction, and the registerNumber function it
+ * uses for register names.
+ *
+ * An operand token is one of:
+ *      - a register:  a name such as $t0 or $zero, or a number such as $8
+ *                     (0 - 31);
+ *      - a number:    decimal (23, -4, +7) or hexadecimal (0x1F, -0x10);
+ *      - a label:     anything else, e.g., loop.
+ * A memory operand such as 4($sp) is split by getNTokens into a number
+ * token (the offset) and a register token (the base), each parsed here.
+ *
+ * Each token is examined exactly once: its kind and value are returned
+ * together, so that callers never need to parse it again, and numbers
+ * are checked for overflow as they are read.  Whether the value fits in
+ * a particular field is up to the caller (see fieldFits).
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include <limits.h>
+
+/* Returns the number of the register named name (which starts with '$'),
+ * or -1 if it is not a valid register name.
+ */
+int registerNumber(const char * name)
+{
+    char kind = name[1], digit = name[2];
+    int  n;
+
+    /* Numbered registers: $0 - $31. */
+    if ( isdigit((unsigned char) kind) )
+    {
+        n = kind - '0';
+        if ( isdigit((unsigned char) digit) && n != 0 )
+        {
+            n = 10 * n + (digit - '0');
+            return n < 32 && name[3] == '\0' ? n : -1;
+        }
+        return digit == '\0' ? n : -1;
+    }
+
+    /* Named registers: a letter and a digit, or one of a few words. */
+    if ( kind == '\0' || digit == '\0' )
+        return -1;
+    if ( name[3] != '\0' )
+        return strcmp(name, "$zero") == SAME ? 0 : -1;
+    n = digit - '0';
+    switch ( kind )
+    {
+        case 'v': return n >= 0 && n <= 1 ? 2 + n : -1;
+        case 'a': return n >= 0 && n <= 3 ? 4 + n :
+                         digit == 't' ? 1 : -1;
+        case 't': return n >= 0 && n <= 7 ? 8 + n :
+                         n >= 8 && n <= 9 ? 24 + n - 8 : -1;
+        case 's': return n >= 0 && n <= 7 ? 16 + n :
+                         digit == 'p' ? 29 : -1;
+        case 'k': return n >= 0 && n <= 1 ? 26 + n : -1;
+        case 'g': return digit == 'p' ? 28 : -1;
+        case 'f': return digit == 'p' ? 30 : -1;
+        case 'r': return digit == 'a' ? 31 : -1;
+    }
+    return -1;
+}
+
+/* Classifies an operand token and finds its value.
+ *    @param token    the token (e.g., "$t0", "-4", "0x10", or "loop")
+ *    @param operand  address where the kind (OPERAND_REGISTER,
+ *                    OPERAND_NUMBER, or OPERAND_LABEL) and value
+ *                    (register number or number; 0 for a label) of the
+ *                    token are placed, along with the token itself
+ *    @return  1 if the token is a valid operand; 0 if it is an invalid
+ *             register name or a malformed number (the kind is still
+ *             set, and no error message is printed)
+ */
+int parseOperand(char * token, Operand * operand)
+{
+    const char * digits = token;
+    int          negative = 0, base = 10;
+    long         value = 0;
+
+    operand->text = token;
+    operand->value = 0;
+
+    if ( *token == '$' )
+    {
+        operand->kind = OPERAND_REGISTER;
+        operand->value = registerNumber(token);
+        return operand->value != -1;
+    }
+
+    if ( ! isdigit((unsigned char) *token) && *token != '-' &&
+         *token != '+' )
+    {
+        operand->kind = OPERAND_LABEL;
+        return 1;
+    }
+
+    /* A number: optional sign, then decimal digits or 0x and hex
+     * digits.
+     */
+    operand->kind = OPERAND_NUMBER;
+    if ( *digits == '-' || *digits == '+' )
+        negative = *digits++ == '-';
+    if ( digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X') )
+    {
+        base = 16;
+        digits += 2;
+    }
+    if ( *digits == '\0' )
+        return 0;
+    for ( ; *digits != '\0'; digits++ )
+    {
+        int d;
+
+        if ( isdigit((unsigned char) *digits) )
+            d = *digits - '0';
+        else if ( base == 16 && isxdigit((unsigned char) *digits) )
+            d = tolower((unsigned char) *digits) - 'a' + 10;
+        else
+            return 0;
+        if ( value > (LONG_MAX - d) / base )
+            return 0;   /* too large for any field */
+        value = value * base + d;
+    }
+    operand->value = negative ? -value : value;
+    return 1;
+}
@@ -18,38 +18,74 @@
  *
  * Modified by:  Alyce Brady, 6/10/2014
  *      Take open file pointer as parameter, rather than filename.
+ * Modified: 10/19/2026
+ *      Added pass1IntoTable, which fills a table the caller owns (e.g.,
+ *      one whose storage lives in an assembly context's arena).
+ *      getLabel is also used by streamPass.  pass1IntoTable returns
+ *      the number of lines read.
+ * Modified: 10/19/2026
+ *      Only lines holding an instruction take up 4 bytes; a label on a
+ *      line by itself (or before blank and comment lines) gets the
+ *      address of the next instruction.  setLineAddresses restores the
+ *      original numbering, in which every line takes up 4 bytes.
+ *      instructionSize and addressStep make sure every pass assigns
+ *      the same addresses.  Directives take up no space, except
+ *      .word, which holds a word.
  *
  */
 
 #include "assembler.h"
 
-/* Declare function used internally within this file. */
-char * getLabel(char * input);
+/* Whether every line takes up 4 bytes (see setLineAddresses). */
+static int lineAddresses = 0;
 
 LabelTableArrayList pass1 (FILE * fp)
   /* returns a copy of the label table that was constructed */
 {
     LabelTableArrayList table;     /* the table of labels & addresses */
+
+    tableInit (&table);
+    pass1IntoTable (fp, &table);
+    return table;
+}
+
+/* Reads the assembly source in fp, adding every label found at the
+ * beginning of a line to table (which must already be initialized),
+ * along with the address of its instruction (or, for a label with no
+ * instruction after it on its line, of the next instruction).  Only the
+ * label table is kept; the lines themselves are read one at a time.
+ *    @param fp     the open assembly source file
+ *    @param table  the label table to fill in
+ *    @return       the number of lines read
+ */
+int pass1IntoTable (FILE * fp, LabelTableArrayList * table)
+{
     int    PC = 0;                 /* the program counter */
+    int    numLines = 0;
+    int    size;                   /* bytes the line takes up */
     char   inst[BUFSIZ];           /* will hold instruction; BUFSIZ
                                       is max size of I/O buffer
                                       (defined in stdio.h) */
     char * label;                  /* label found in an instruction */
 
     /* create a small label table to begin with */
-    tableInit (&table);
-    if ( tableResize (&table, 10) == 0)
+    if ( table->capacity < 10 && tableResize (table, 10) == 0)
     {
         /* error message already printed */
-        return table;
+        return 0;
     }
 
     /* Continuously read next line of input until EOF is encountered.
      * Check each line to see if it has a label; if it does, add it
      * to the label table.
      */
-    for (PC = 0; fgets (inst, BUFSIZ, fp); PC += 4)
+    for (PC = 0; fgets (inst, BUFSIZ, fp); PC += size, numLines++)
     {
+        /* Find how much space the line takes up before getLabel changes
+         * it.
+         */
+        size = instructionSize (inst, strlen (inst));
+
         /* Get the label, if there is one on this line. */
         label = getLabel(inst);
 
@@ -59,12 +95,89 @@ LabelTableArrayList pass1 (FILE * fp)
             /* Label found: add to table.
              * (If there's an error, addLabel should print the error message.)
              */
-            addLabel (&table, label, PC);
+            addLabel (table, label, PC);
         }
     }
 
     /* EOF, but don't close the file here. */
-    return table;
+    return numLines;
+}
+
+void setLineAddresses(int on)
+{
+    lineAddresses = on;
+}
+
+int usesLineAddresses(void)
+{
+    return lineAddresses;
+}
+
+/* Returns 1 if the token at p (which ends by end) is ".word", as
+ * getToken would find it.
+ */
+static int isWordDirective(const char * p, const char * end)
+{
+    const char * after = p + 5;
+
+    return end - p >= 5 && strncmp(p, ".word", 5) == SAME &&
+           (after == end || *after == '\0' || *after == '#' ||
+            *after == ',' || *after == '(' || *after == ')' ||
+            *after == ':' || isspace((unsigned char) *after));
+}
+
+/* Returns the number of bytes a line takes up in the program: 4 if it
+ * holds an instruction (valid or not) or a .word directive, 0 if it is
+ * blank or holds only a label, a comment, or another directive -- or 4
+ * for every line, if setLineAddresses(1) was called.  A line holds an
+ * instruction exactly when getInstName finds a name on it, i.e., when
+ * anything but whitespace follows the label (if any) and comes before
+ * the comment (if any), and that name does not start with '.' (see
+ * decodeLine).
+ *    @param line    the line (not changed, and not necessarily
+ *                   null-terminated)
+ *    @param length  the number of characters in the line
+ *    @return        4 or 0
+ */
+int instructionSize(const char * line, size_t length)
+{
+    const char * p = line, * end = line + length;
+    const char * first;         /* the first token */
+
+    if ( lineAddresses )
+        return 4;
+
+    /* Skip whitespace to the first token, then find its end, as
+     * getToken would (a comment ends it, too).
+     */
+    while ( p < end && isspace((unsigned char) *p) )
+        p++;
+    if ( p == end || *p == '\0' || *p == '#' )
+        return 0;
+    for ( first = p++; p < end && *p != '\0' && *p != '#' && *p != ',' &&
+               *p != '(' && *p != ')' && *p != ':' &&
+               ! isspace((unsigned char) *p); p++ )
+        ;
+    if ( p == end || *p != ':' )
+        p = first;      /* the first token is the instruction name */
+    else
+    {
+        /* The first token is a label: is there anything after it? */
+        for ( p++; p < end && isspace((unsigned char) *p); p++ )
+            ;
+        if ( p == end || *p == '\0' || *p == '#' )
+            return 0;
+    }
+    return *p != '.' || isWordDirective(p, end) ? 4 : 0;
+}
+
+/* Returns the number of bytes by which the address advances past a line
+ * that decodeLine (or assembleLine) returned result for.  This agrees
+ * with instructionSize, without looking at the line again.
+ */
+int addressStep(int result)
+{
+    return result != ASM_NONE || lineAddresses ? 4 : 0;
 }
 
 /* Get label.
@@ -12,374 +12,322 @@
  * Author: Tabitha Rowland
  * Date:   3/8/2022
  *
- * Modified by:  
- *      Why?
+ * Modified: 10/19/2026
+ *      Encode each instruction as a word (assembleLine) from its template
+ *      in the instruction table (decodeLine, processOperands; see
+ *      instrTable.h), and format it for output separately (see
+ *      setOutputFormat).  Only lines holding an instruction (or a
+ *      .word directive) take an address (see addressStep).
  *
  */
 
 #include "assembler.h"
+#include "encodeCache.h"
 #include <stdlib.h>
 #include <ctype.h>
 
 void pass2 (FILE * fp, LabelTableArrayList * table)
 {
     int    lineNum;            /* line number */
-    int    PC = 0;             /* program counter */
+    int    address = 0;        /* address of this line's instruction */
     char   inst[BUFSIZ];       /* will hold instruction; BUFSIZ is max size
                                     of I/O buffer (defined in stdio.h) */
-    char * instrName;          /* instruction name (e.g., "add") */
-    char * restOfInstruction;  /* rest of instruction (e.g., "$t0, $t1, $t2") */
+    char   output[MAX_WORD_LENGTH];  /* one instruction of output */
+    unsigned int word;         /* the machine code for one instruction */
+    InstrFields fields;        /* its fields, if it had to be decoded */
+    EncodeCache cache;         /* instructions already encoded */
+    int    result;
+
+    cacheInit(&cache);
 
     /* Continuously read next line of input until EOF is encountered.
      */
     for (lineNum = 1; fgets (inst, BUFSIZ, fp); lineNum++)
     {
-        PC += 4;
-
-        /* Separate the instruction name from the rest of the statement.
-         * If the line does not have an instruction, move on to next line.
-         */
-        getInstName(inst, &instrName, &restOfInstruction);
-        if ( instrName == NULL )
-            continue; /* Go to top of loop to read next line of input. */
-
-        printDebug ("First non-label token is: %s\n", instrName);
-
-        /* Determine whether this is an R-format, I-format, or J-format
-         * instruction based on the opcode.  If it is an R-format
-         * instruction, get the funct code also.  Then process the
-         * instruction.
+        /* Encode the instruction on this line (if any), unless it is
+         * in the cache, and print it.  The PC is the address of the
+         * following instruction.
          */
-        int opcode = getOpCode(instrName);
-        printDebug("%s instruction has opcode %d.\n", instrName, opcode);
-        if ( opcode == 0 )
-        {
-            int functCode = getFunctCode(instrName);
-            printDebug("%s instruction has funct code %d.\n",
-                    instrName, functCode);
-            if ( functCode == -1 )
-            {
-                /* Print error message - this is not a valid instruction!  */
-                printf("Invalid instruction %s on line %d.\n", instrName,
-                        lineNum);
-                continue; /* Go to top of loop to read next line of input. */
-            }
-
-            processR(lineNum, functCode, restOfInstruction);
-        }
-        else
+        result = cacheDecode(&cache, inst, lineNum, address + 4, table,
+                             &fields, &word, NULL);
+        address += addressStep(result);
+        if ( result == ASM_OK )
+            word = packFields(&fields);
+        if ( result == ASM_OK || result == ASM_CACHED )
         {
-            processIorJ(lineNum, table, opcode, restOfInstruction, PC);
+            fwrite(output, 1, formatWord(word, output), stdout);
         }
     }
 
+    cacheFree(&cache);
     return;
 }
 
 
-/* Checks the opcode name with the I, J, and R formats, and
- *  returns the corresponding opcode. If the instrName is
- *  not one of those, it returns -1.
- *    @param instrName      name of instruction (input)
- *    @return  the opCode if instrName is a valid I or J format instruction,
- *             or 0 (i.e., if instrName is a valid R format instruction). -1 
- *              is not a valid opcode at all. 
+/* Encodes the instruction on one line of assembly source.
+ *    @param inst     the line read in (modified by this function)
+ *    @param lineNum  line number (for error messages)
+ *    @param PC       program counter (address of the following
+ *                    instruction)
+ *    @param table    label table
+ *    @param word     address where the 32-bit machine code is placed
+ *    @param unresolved  NULL if every label referred to must already be
+ *             in the table; otherwise a reference to a label that is not
+ *             in the table is not an error, but is described here (its
+ *             kind is REF_NONE if there was no such reference)
+ *    @return  ASM_OK if the line held a valid instruction, ASM_NONE if
+ *             the line held no instruction (it was empty, or held only
+ *             a label, comment, or directive), or ASM_ERROR if the instruction was
+ *             invalid (an error message has been printed)
  */
-int getOpCode(char * instrName)
+int assembleLine(char * inst, int lineNum, int PC,
+                 LabelTableArrayList * table, unsigned int * word,
+                 LabelRef * unresolved)
 {
-    
-    int opcode = 0;
-    if ( strcmp(instrName, "beq") == SAME ) //
-        opcode = 4;
-    else if (strcmp(instrName, "bne") == SAME)
-        opcode = 5;
-    else if (strcmp(instrName, "addi") == SAME)
-        opcode = 8;
-    else if (strcmp(instrName, "addiu") == SAME)
-        opcode = 9;
-    else if (strcmp(instrName, "slti") == SAME)
-        opcode = 10;
-    else if (strcmp(instrName, "sltiu") == SAME)
-        opcode = 11;
-    else if (strcmp(instrName, "andi") == SAME)
-        opcode = 12;
-    else if (strcmp(instrName, "ori") == SAME)
-        opcode = 13;
-    else if (strcmp(instrName, "lui") == SAME)
-        opcode = 15;
-    else if (strcmp(instrName, "lw") == SAME)
-        opcode = 35;
-    else if (strcmp(instrName, "sw") == SAME) //end of I format instructions
-        opcode = 43;
-    else if (strcmp(instrName, "j") == SAME) //beginning of J format
-        opcode = 2;
-    else if (strcmp(instrName, "jal") == SAME) //end of J instruct
-        opcode = 3;
-    else if (strcmp(instrName, "jal") == SAME) //beginning of R
-        opcode = 3;
-    else if (strcmp(instrName, "sll") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "srl") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "jr") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "add") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "addu") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "sub") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "subu") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "and") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "or") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "nor") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "slt") == SAME)
-        opcode = 0;
-    else if (strcmp(instrName, "sltu") == SAME)
-        opcode = 0;
-    else //if its not these, then it is not a valid MIPS instruction. 
-    {
-        printDebug("This is an invaid opcode: %s \n", instrName);
-        return -1;
-        }
-    
-    return opcode;
-}
+    InstrFields fields;
+    int         result = decodeLine(inst, lineNum, PC, table, &fields,
+                                    unresolved);
 
-/* Checks the functcode name with the R formats, and
- *  returns the corresponding functcode. If the instrName is
- *  not one of those, it returns -1.
- *    @param instrName      name of instruction (input)
- *    @return  the funct code if instrName is a valid R format instruction, 
- *             or -1 if instrName is not a valid R format instruction
- */
-int getFunctCode(char * instrName)
-{
-    int functCode = 0;
-    if ( strcmp(instrName, "sll") == SAME )
-        functCode = 0;
-    else if ( strcmp(instrName, "srl") == SAME )
-        functCode = 2;
-    else if ( strcmp(instrName, "jr") == SAME )
-        functCode = 8;
-    else if ( strcmp(instrName, "add") == SAME )
-        functCode = 32;
-    else if ( strcmp(instrName, "addu") == SAME )
-        functCode = 33;
-    else if ( strcmp(instrName, "sub") == SAME )
-        functCode = 34;
-    else if ( strcmp(instrName, "subu") == SAME )
-        functCode = 35;
-    else if ( strcmp(instrName, "and") == SAME )
-        functCode = 36;
-    else if ( strcmp(instrName, "or") == SAME )
-        functCode = 37;
-    else if ( strcmp(instrName, "nor") == SAME )
-        functCode = 39;
-    else if ( strcmp(instrName, "slt") == SAME )
-        functCode = 42;
-    else if ( strcmp(instrName, "sltu") == SAME )
-        functCode = 43;
-    else /* instrName not recognized */
-        {printDebug("This is an invaid functcode: %s \n", instrName);
-        functCode = -1;}
-    
-    return functCode;
+    if ( result == ASM_OK )
+        *word = packFields(&fields);
+    return result;
 }
 
 
-/* Takes the functcode and checks for how many arguments there are, then looks for them.
- * Formats them in the correct order, and returns it.
- *
- * When getNTokens encounters an error, it puts a pointer to the error
- * message in arguments[0].
+/* Places the value of a .word directive in fields, split as though it
+ * were an instruction, so that packing them gives the value back.  The
+ * value may be any number that fits in 32 bits, signed or not.
+ * Returns ASM_OK, or ASM_ERROR if an error message was printed.
  */
-void processR(int lineNum, int functCode, char * restOfInstruction)
+static int processWord(int lineNum, char * restOfInstruction,
+                       InstrFields * fields)
 {
-    char * arguments[3];      /* registers or values after name; max of 3 */
-    int numOperands;
+    char *  arguments[1];
+    Operand operand;
 
-    if (functCode == -1) //if functcode is invalid
+    if ( ! getNTokens(restOfInstruction, 1, arguments) )
     {
-        printError("Functcode is invalid on line %d.\n", lineNum);
-        return;
-    }
-
-    /* JR only has 1 operand; all other R-format instructions have 3. */
-    if ( functCode == 8 )
-    {
-        numOperands = 1;
+        printError("Error on line %d: %s\n", lineNum, arguments[0]);
+        return ASM_ERROR;
     }
-    else
+    if ( ! parseOperand(arguments[0], &operand) ||
+         operand.kind != OPERAND_NUMBER ||
+         operand.value < -2147483648L || operand.value > 0xFFFFFFFFL )
     {
-        numOperands = 3;
+        printError("Line %d: %s is not a valid 32-bit word.\n", lineNum,
+                   arguments[0]);
+        return ASM_ERROR;
     }
-    
-    /* Get arguments.  (Depending on instruction, should be 1, 2, or 3.) */
-    if ( ! getNTokens(restOfInstruction, numOperands, arguments) )
+    fieldsFromBase(fields, (unsigned int) operand.value);
+    return ASM_OK;
+}
+
+
+/* Decodes the instruction on one line of assembly source into its
+ * numeric fields, without packing them into a word, so that callers
+ * can pack many instructions at once (see packBlock).  The parameters
+ * and result are as for assembleLine, except that the fields are placed
+ * in fields.
+ */
+int decodeLine(char * inst, int lineNum, int PC,
+               LabelTableArrayList * table, InstrFields * fields,
+               LabelRef * unresolved)
+{
+    char * instrName;          /* instruction name (e.g., "add") */
+    char * restOfInstruction;  /* rest of instruction (e.g., "$t0, $t1, $t2") */
+    const InstrTemplate * template;
+
+    if ( unresolved != NULL )
+        unresolved->kind = REF_NONE;
+
+    /* Separate the instruction name from the rest of the statement.
+     * If the line does not have an instruction, move on to next line.
+     */
+    getInstName(inst, &instrName, &restOfInstruction);
+    if ( instrName == NULL )
+        return ASM_NONE;
+
+    printDebug ("First non-label token is: %s\n", instrName);
+
+    /* A directive (e.g., .globl) is not an instruction.  .word places a
+     * word of its own; .globl matters only to objectPass.
+     */
+    if ( strcmp(instrName, ".word") == SAME )
+        return processWord(lineNum, restOfInstruction, fields);
+    if ( *instrName == '.' )
     {
-        printError("Error on line %d: %s\n", lineNum, arguments[0]);
-        return;
+        if ( strcmp(instrName, ".globl") != SAME &&
+             strcmp(instrName, ".global") != SAME )
+            printError("Unknown directive %s on line %d is ignored.\n",
+                       instrName, lineNum);
+        return ASM_NONE;
     }
 
-    /* Process arguments and print machine code version of instruction. */
-    if ( functCode == 8 )       /* Handle jr instruction */
+    /* Find the instruction's template, which says how to encode it. */
+    template = findTemplate(instrName);
+    if ( template == NULL )
     {
-        printDebug("jr \"%s\" on line %d. \n", arguments[0], lineNum);
+        /* Print error message - this is not a valid instruction!  */
+        printError("Invalid instruction %s on line %d.\n", instrName,
+                lineNum);
+        return ASM_ERROR;
+    }
+    printDebug("%s instruction has base word 0x%08x.\n", instrName,
+               template->base);
 
+    return processOperands(lineNum, table, template, restOfInstruction, PC,
+                           fields, unresolved);
+}
 
-        printInt(0, 6); //opcode
-        printReg(arguments[0], lineNum); 
-        printInt(0, 15); //zeros, empty space after the one and only reg num
-        printInt(functCode, 6);
-        printf(" \n");
 
+/* Fills in the label's field of an instruction that referred to a label
+ * before the label was defined.
+ *    @param word     address of the instruction, as encoded by
+ *                    assembleLine; it is completed by this function
+ *    @param ref      the unresolved reference assembleLine described
+ *    @param address  the address of the label, now that it is defined
+ *    @return  1 if the instruction was completed; 0 if the label is too
+ *             far away for a branch to reach
+ */
+int patchLabelRef(unsigned int * word, const LabelRef * ref, int address)
+{
+    int offset = (address - ref->PC) / 4;
 
-    }
-    else if ( functCode == 0 || functCode == 2 )     // Handle sll and srl
-      {
-            // Shift amount is a number in a string, not an int
-            printDebug("This is an sll or an srl. funct: %d. reg1: %s. reg2: %s. shift amount = %s. On line %d. \n", functCode, arguments[0], arguments[1], arguments[2], lineNum);
-            printInt(0, 6); //opcode
-            printInt(0, 5); //zero for 5 bits
-            printReg(arguments[1], lineNum);
-            printReg(arguments[0], lineNum); //check with mips instruction table, the format is wonky for lots of them
-            printIntInString(arguments[2], 5, lineNum);
-            printInt(0, 6);
-            printf(" \n");
-      }
-    
-    else            /* Handle common format for add, etc. */
+    if ( ref->kind == REF_BRANCH )
     {
-        printDebug("funct %d \"%s\", \"%s\", and \"%s\" on line %d.\n", functCode,
-                            arguments[1], arguments[2], arguments[0], lineNum);
-
-        /* Print binary for the opcode, registers, shift amount,
-         * and funct code.
-         */
-        
-        printInt(0, 6);
-        printReg(arguments[1], lineNum);
-        printReg(arguments[2], lineNum);
-        printReg(arguments[0], lineNum);
-        printInt(0, 5);
-        printInt(functCode, 6);
-        printf(" \n");
+        if ( offset < -32768 || offset > 32767 )
+            return 0;
+        *word |= (unsigned) offset & 0xFFFF;
     }
+    else if ( ref->kind == REF_JUMP )
+        *word |= (unsigned) (address / 4) & 0x3FFFFFF;
+    return 1;
+}
 
+/* Records in unresolved (if it is not NULL) a reference to a label that
+ * is not yet in the table.  Returns 1 if the reference was recorded, or
+ * 0 if it was not (so the label must be looked up as usual).
+ */
+static int deferLabel(LabelRef * unresolved, LabelTableArrayList * table,
+                      int kind, char * label, int PC, int lineNum)
+{
+    if ( unresolved == NULL || findLabelAddr(table, label) != -1 )
+        return 0;
+
+    unresolved->kind = kind;
+    unresolved->label = label;
+    unresolved->PC = PC;
+    unresolved->lineNum = lineNum;
+    return 1;
 }
 
-/* Takes the opcode and checks for how many arguments there are, then looks for them.
- * Formats them in the correct order along with their opcodes, and returns it.
+
+/* Looks up the operands of an instruction and places each in its field,
+ * as the instruction's template describes.  Each operand is parsed once
+ * (see parseOperand) and must be of a kind its slot accepts.  Every
+ * operand is checked (so that every error on the line is reported) and
+ * must fit in its field.
+ * Returns ASM_OK, or ASM_ERROR if an error message was printed.  A branch
+ * or jump to a label that is not yet in the table is described in
+ * unresolved, if that is not NULL (see assembleLine).
  *
  * When getNTokens encounters an error, it puts a pointer to the error
  * message in arguments[0].
  */
-void processIorJ(int lineNum, LabelTableArrayList * table,
-                 int opcode, char * restOfInstruction, int PC)
+int processOperands(int lineNum, LabelTableArrayList * table,
+                    const InstrTemplate * template, char * restOfInstruction,
+                    int PC, InstrFields * fields, LabelRef * unresolved)
 {
-    char * arguments[3];      /* registers or values after name; max of 3 */
-    int numOperands;
+    char * arguments[MAX_OPERANDS];     /* registers or values after name */
+    int    i, valid = 1;
 
-    if (opcode == -1) //if opcode is invalid
+    /* Get arguments.  (Depending on instruction, should be 0 to 3.) */
+    if ( template->numOperands == 0 )
     {
-        printError("Opcode is invalid on line %d.\n", lineNum);
-        return;
-    }
+        char * tokBegin = restOfInstruction, * tokEnd;
 
-    if ( opcode == 15 ) //lui has 2 only
-    {
-        numOperands = 2;
-    }
-    else if ( opcode == 2 || opcode == 3 ) //j or jal has 1 arg
-    {
-        numOperands = 1;
-    }
-    else
-    {
-        numOperands = 3;
+        getToken(&tokBegin, &tokEnd);
+        if ( *tokBegin != '\0' )
+        {
+            printError("Error on line %d: %s\n", lineNum,
+                       "Instruction contains more tokens than expected.");
+            return ASM_ERROR;
+        }
     }
-
-
-    /* Get arguments.  (Depending on instruction, should be 1, 2, or 3.) */
-    if ( ! getNTokens(restOfInstruction, numOperands, arguments) )
+    else if ( ! getNTokens(restOfInstruction, template->numOperands,
+                           arguments) )
     {
         printError("Error on line %d: %s\n", lineNum, arguments[0]);
-        return;
+        return ASM_ERROR;
     }
 
-    if ( opcode == 15 )       /* Handle lui instruction */
+    /* Start from the constant fields, and add each operand. */
+    fieldsFromBase(fields, template->base);
+    for ( i = 0; i < template->numOperands; i++ )
     {
-        printDebug("lui \"%s\", \"%s\"\n", arguments[0], arguments[1]);
-
+        const OperandSlot * slot = &template->slots[i];
+        Operand operand;
+        int     ok = parseOperand(arguments[i], &operand);
 
-        printInt(opcode, 6); //opcode
-        printInt(0, 5);
-        printReg(arguments[0], lineNum); 
-        printIntInString(arguments[1], 16, lineNum); //constant, takes up 16 bits
-        printf("\n");
+        printDebug("%s operand %d: \"%s\" (kind %d, value %ld) on line "
+                   "%d.\n", template->name, i, operand.text, operand.kind,
+                   operand.value, lineNum);
 
-    }
-    else if ( opcode == 35 || opcode == 43) //lw or sw
-    {
-        printDebug("This is a lw or sw, reg1 is %s, constant is %s, reg2 is %s.\n",arguments[0],arguments[1],arguments[2]);
-        printInt(opcode, 6); //opcode
-        printReg(arguments[2], lineNum);
-        printReg(arguments[0], lineNum);
-        printIntInString(arguments[1], 16, lineNum);
-        printf("\n");
-    }
-    else if ( opcode == 4 || opcode == 5) //beq, bne
-    {
-        int intConstant = atoi(arguments[2]);
-        char * targetLabel;
-
-        printDebug("opcode: %d, reg1: %s, reg2: %s, constant: %s. On line %d. \n", opcode, arguments[0], arguments[1], arguments[2], lineNum);
-        printInt(opcode, 6); //opcode
-        printReg(arguments[0], lineNum);
-        printReg(arguments[1], lineNum);
-        if (atoi(arguments[2]) == 0) //if the string contains letters, it returns 0. 
+        /* The operand must be of a kind its slot accepts: a register for
+         * a register; a number for an immediate; a label or a number for
+         * a branch or jump.
+         */
+        if ( slot->kind == OPND_REG )
         {
-            targetLabel = arguments[2];
-            printBranchOffset(targetLabel, table, PC, lineNum);
+            if ( operand.kind != OPERAND_REGISTER || ! ok )
+            {
+                printError("Line: %d. This register %s is invalid.\n",
+                           lineNum, operand.text);
+                valid = 0;
+                continue;
             }
-        else {
-            intConstant = atoi(arguments[2]);
-            printInt(intConstant, 16); } //constant
-        printf("\n");
-
-    }
-    else if (opcode == 2 || opcode == 3 ) //j or jal
-    {
-        char * targetLabel;
-        int intConstant;
-        
-        printDebug("opcode: %d, constant: %s, On line %d. \n", opcode, arguments[0], lineNum);
-        printInt(opcode, 6); //opcode
-        if (atoi(arguments[0]) == 0) //if the string contains letters, it returns 0. 
+        }
+        else if ( ! ok || operand.kind == OPERAND_REGISTER ||
+                  (slot->kind == OPND_IMM && operand.kind == OPERAND_LABEL) )
         {
-            targetLabel = arguments[0];
-            printJumpTarget(arguments[0], table, lineNum); //constant
+            printError("Line %d: %s is not a valid %s.\n", lineNum,
+                       operand.text, slot->kind == OPND_IMM ? "integer"
+                                                  : "label or integer");
+            valid = 0;
+            continue;
+        }
+        else if ( operand.kind == OPERAND_LABEL )
+        {
+            int value;
+
+            if ( deferLabel(unresolved, table, slot->kind == OPND_BRANCH
+                            ? REF_BRANCH : REF_JUMP, operand.text, PC,
+                            lineNum) )
+                continue;       /* the field is filled in later */
+            ok = slot->kind == OPND_BRANCH
+                 ? getBranchOffset(operand.text, table, PC, lineNum, &value)
+                 : getJumpTarget(operand.text, table, lineNum, &value);
+            if ( ! ok )
+            {
+                valid = 0;
+                continue;
             }
-        else {
-            intConstant = atoi(arguments[0]);
-            printInt(intConstant, 26); } //constant
-         
-        printf("\n");
-    }
-    
-    else //this is the format for all other I and J 
-    {   printDebug("opcode: %d, reg1: %s, reg2: %s, constant: %s. On line %d. \n", opcode, arguments[0], arguments[1], arguments[2], lineNum);
-        printInt(opcode, 6); //opcode
-        printReg(arguments[1], lineNum);
-        printReg(arguments[0], lineNum);
-        printIntInString(arguments[2], 16, lineNum); //constant
-        printf("\n");
+            operand.value = value;
+        }
+
+        if ( ! fieldFits(slot, operand.value) )
+        {
+            if ( operand.kind == OPERAND_LABEL )
+                printError("Line %d: branch target %s is too far away.\n",
+                           lineNum, operand.text);
+            else
+                printError("Line %d: %s does not fit in a %d-bit field.\n",
+                           lineNum, operand.text, slot->width);
+            valid = 0;
+            continue;
+        }
+        placeField(fields, slot, (unsigned) operand.value);
     }
 
+    return valid ? ASM_OK : ASM_ERROR;
 }
-
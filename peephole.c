@@ -0,0 +1,203 @@
+/**
+ * long peephole (Code * code, FILE * statsFp)
+ *      @param  code  the program, taken apart (see transform.h)
+ *      @param  statsFp  where to report what was done (NULL for nowhere)
+ *      @return the number of instructions saved, or -1 if memory could
+ *              not be allocated
+ *
+ * This function removes obvious waste from a program by matching each
+ * instruction, and the one after it, against a table of patterns and
+ * rewriting what matches:
+ *
+ *      - a move to itself (add $x, $x, $zero, or $x, $zero, $x,
+ *        addi $x, $x, 0, sll $x, $x, 0, ...) is deleted;
+ *      - a jump, or a beq or bne, to the very next instruction is
+ *        deleted;
+ *      - a j or jal to a j goes straight to where that j goes (following
+ *        a chain of them, unless it loops).
+ *
+ * A pinned instruction (see transform.h), which a label, branch, or jump
+ * refers to, is never deleted, and a nop (sll $zero, $zero, 0) is left
+ * alone, since it may be there on purpose.  Since one rewrite can make
+ * another possible (a jump chain shortened to a jump to the next
+ * instruction, say), the table is applied until nothing more matches, up
+ * to MAX_ROUNDS times.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "transform.h"
+
+#define MAX_ROUNDS  8
+#define MAX_HOPS    16          /* jumps followed along a chain */
+
+#define OP_J    2
+#define OP_JAL  3
+#define OP_BEQ  4
+#define OP_BNE  5
+
+/* The program during one round of rewrites. */
+typedef struct {
+        Code * code;
+        long * positions;       /* see codePositions */
+        char * deleted;         /* by index in code */
+} Peephole;
+
+/* A pattern: applies its rewrite to the instruction at index i and
+ * returns 1 if the instruction matches; returns 0 if it does not.
+ */
+typedef struct {
+        const char * name;
+        int (*rewrite)(Peephole * pass, long i);
+} Pattern;
+
+/* Returns the index of the first instruction after i not deleted. */
+static long nextLive(const Peephole * pass, long i)
+{
+    for ( i++; i < pass->code->numInstrs && pass->deleted[i]; i++ )
+        ;
+    return i;
+}
+
+/* Returns the index of the instruction that the branch or jump instr
+ * goes to, or -1 if it goes outside the program or is not one.
+ */
+static long targetIndex(const Peephole * pass, const CodeInstr * instr)
+{
+    long target = instr->target;
+
+    if ( target < 0 || target % 4 != 0 ||
+         target / 4 > pass->code->numOriginal )
+        return -1;
+    return nextLive(pass, pass->positions[target / 4] - 1);
+}
+
+/* add, addu, sub, subu, or, xor $x, $x, $zero (or, for those that do not
+ * care about the order, $x, $zero, $x); addi, addiu, ori, xori $x, $x, 0;
+ * and sll, srl, sra $x, $x, 0.
+ */
+static int deleteSelfMove(Peephole * pass, long i)
+{
+    const CodeInstr * instr = &pass->code->instrs[i];
+    unsigned int      word = instr->word, opcode = word >> 26,
+                      rs = (word >> 21) & 0x1F, rt = (word >> 16) & 0x1F,
+                      rd = (word >> 11) & 0x1F, funct = word & 0x3F;
+    int               match = 0;
+
+    if ( instr->pinned || word == 0 || decodeTemplate(word) == NULL )
+        return 0;
+    if ( opcode == 0 && (funct >= 32 && funct <= 38 && funct != 36) )
+        match = (rd == rs && rt == 0) ||
+                (rd == rt && rs == 0 && funct != 34 && funct != 35);
+    else if ( opcode == 0 && (funct == 0 || funct == 2 || funct == 3) )
+        match = rd == rt && ((word >> 6) & 0x1F) == 0;
+    else if ( opcode == 8 || opcode == 9 || opcode == 13 || opcode == 14 )
+        match = rt == rs && (word & 0xFFFF) == 0;
+    if ( match )
+        pass->deleted[i] = 1;
+    return match;
+}
+
+/* j, beq, or bne to the next instruction. */
+static int deleteJumpToNext(Peephole * pass, long i)
+{
+    const CodeInstr * instr = &pass->code->instrs[i];
+    unsigned int      opcode = instr->word >> 26;
+
+    if ( instr->pinned ||
+         (opcode != OP_J && opcode != OP_BEQ && opcode != OP_BNE) ||
+         targetIndex(pass, instr) != nextLive(pass, i) )
+        return 0;
+    pass->deleted[i] = 1;
+    return 1;
+}
+
+/* j or jal to a j. */
+static int shortenJumpChain(Peephole * pass, long i)
+{
+    CodeInstr * instrs = pass->code->instrs;
+    long        next = targetIndex(pass, &instrs[i]);
+    long        target = instrs[i].target;
+    int         hops;
+
+    if ( instrs[i].word >> 26 != OP_J && instrs[i].word >> 26 != OP_JAL )
+        return 0;
+    for ( hops = 0; next >= 0 && next < pass->code->numInstrs &&
+                    instrs[next].word >> 26 == OP_J; hops++ )
+    {
+        if ( hops == MAX_HOPS )
+            return 0;           /* a loop of jumps */
+        target = instrs[next].target;
+        next = targetIndex(pass, &instrs[next]);
+    }
+    if ( target == instrs[i].target )
+        return 0;
+    instrs[i].target = target;
+    return 1;
+}
+
+static const Pattern PATTERNS[] = {
+    { "moves to self", deleteSelfMove },
+    { "jumps to the next instruction", deleteJumpToNext },
+    { "jump chains", shortenJumpChain }
+};
+
+#define NUM_PATTERNS  (int) (sizeof(PATTERNS) / sizeof(PATTERNS[0]))
+
+long peephole (Code * code, FILE * statsFp)
+{
+    long     counts[NUM_PATTERNS], rewrites = 0, original = code->numInstrs;
+    long     i, numNew;
+    int      p, round, changed = 1;
+    Peephole pass;
+
+    memset(counts, 0, sizeof(counts));
+    pass.code = code;
+    for ( round = 0; changed && round < MAX_ROUNDS; round++ )
+    {
+        CodeInstr * out;
+
+        pass.positions = codePositions(code);
+        pass.deleted = calloc(code->numInstrs + 1, 1);
+        out = malloc((code->numInstrs + 1) * sizeof(CodeInstr));
+        if ( pass.positions == NULL || pass.deleted == NULL || out == NULL )
+        {
+            if ( pass.positions != NULL )
+                printError("Error: cannot allocate space in memory.\n");
+            free(pass.positions);
+            free(pass.deleted);
+            free(out);
+            return -1;
+        }
+
+        changed = 0;
+        for ( i = 0; i < code->numInstrs; i++ )
+            for ( p = 0; ! pass.deleted[i] && p < NUM_PATTERNS; p++ )
+                if ( PATTERNS[p].rewrite(&pass, i) )
+                {
+                    counts[p]++;
+                    rewrites++;
+                    changed = 1;
+                    break;
+                }
+
+        for ( i = 0, numNew = 0; i < code->numInstrs; i++ )
+            if ( ! pass.deleted[i] )
+                out[numNew++] = code->instrs[i];
+        codeReplace(code, out, numNew);
+        free(pass.positions);
+        free(pass.deleted);
+    }
+
+    if ( statsFp != NULL )
+    {
+        fprintf(statsFp, "peephole: %ld rewrites (", rewrites);
+        for ( p = 0; p < NUM_PATTERNS; p++ )
+            fprintf(statsFp, "%s%ld %s", p == 0 ? "" : ", ", counts[p],
+                    PATTERNS[p].name);
+        fprintf(statsFp, "); %ld instructions saved\n",
+                original - code->numInstrs);
+    }
+    return original - code->numInstrs;
+}
@@ -0,0 +1,275 @@
+/**
+ * int pass2Pipelined (FILE * fp, LabelTableArrayList * table)
+ *      @param  fp  pointer to an open file (stdin or other file pointer)
+ *                  from which to read lines of assembly source code
+ *      @param  table  a pointer to an existing Label Table
+ *      @return 1 if the pipeline ran; 0 if it could not be set up (in
+ *              which case nothing has been read from fp)
+ *
+ * This function does the same work as pass2, but as a three-stage
+ * pipeline so that reading the input, encoding instructions, and
+ * writing the output overlap:
+ *
+ *      reader thread  --line batches-->  encoder thread
+ *      encoder thread --word batches-->  writer thread
+ *
+ * The reader fills batches of lines with fgets, the encoder decodes each
+ * line and packs the fields into 32-bit words a block at a time (see
+ * packBlock), taking repeated instructions from its encode cache
+ * instead, and the writer formats the
+ * words in the output format and writes them to stdout.  The stages are
+ * connected by lock-free single-producer/single-consumer rings.  Each
+ * kind of batch also has a "free" ring running the other way, through
+ * which the consumer hands empty batches back to the producer, so a
+ * fixed number of batches is allocated up front and reused; this also
+ * bounds how far one stage can run ahead of the next.
+ *
+ * The output is identical to pass2's.  Error messages are printed by
+ * the encoder thread, so they may interleave differently with the
+ * output than they do with pass2.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include <pthread.h>
+
+#include "encodeCache.h"
+#include "spscRing.h"
+
+#define LINES_PER_BATCH   1024          /* lines (and words) per batch */
+#define BATCH_TEXT_BYTES  (64 * 1024)   /* text per line batch */
+#define BATCHES_IN_FLIGHT 4             /* batches of each kind */
+#define RING_CAPACITY     8             /* power of two >= in flight */
+
+/* A batch of consecutive lines of input. */
+typedef struct {
+        char * text;            /* the lines, each null-terminated */
+        int    starts[LINES_PER_BATCH];   /* where each line starts */
+        int    numLines;
+        int    last;            /* 1 if this batch ends the input */
+} LineBatch;
+
+/* A batch of encoded instructions. */
+typedef struct {
+        unsigned int words[LINES_PER_BATCH];
+        int    numWords;
+        int    last;            /* 1 if this batch ends the output */
+} WordBatch;
+
+/* Everything the three stages share. */
+typedef struct {
+        FILE * fp;
+        LabelTableArrayList * table;
+        SpscRing fullLines, freeLines;  /* reader -> encoder, and back */
+        SpscRing fullWords, freeWords;  /* encoder -> writer, and back */
+} Pipeline;
+
+static void * readerStage(void * arg)
+{
+    Pipeline * pipe = arg;
+    LineBatch * batch;
+    int eof = 0;
+
+    while ( ! eof )
+    {
+        int used = 0;
+
+        batch = spscPop(&pipe->freeLines);
+        batch->numLines = 0;
+
+        /* Read lines exactly as pass2 does (at most BUFSIZ - 1 characters
+         * at a time), so that line numbers and PCs agree with pass2.
+         */
+        while ( batch->numLines < LINES_PER_BATCH &&
+                used + BUFSIZ <= BATCH_TEXT_BYTES )
+        {
+            char * line = batch->text + used;
+            if ( fgets(line, BUFSIZ, pipe->fp) == NULL )
+            {
+                eof = 1;
+                break;
+            }
+            batch->starts[batch->numLines++] = used;
+            used += strlen(line) + 1;
+        }
+
+        batch->last = eof;
+        spscPush(&pipe->fullLines, batch);
+    }
+    return NULL;
+}
+
+/* Packs the instructions in block and stores them in the slots of the
+ * batch reserved for them; empties the block.
+ */
+static void flushBlock(WordBatch * words, FieldBlock * block,
+                       const int * slots)
+{
+    unsigned int packed[PACK_BLOCK_SIZE];
+    int          i;
+
+    packBlock(block, packed);
+    for ( i = 0; i < block->count; i++ )
+        words->words[slots[i]] = packed[i];
+    block->count = 0;
+}
+
+static void * encoderStage(void * arg)
+{
+    Pipeline * pipe = arg;
+    int lineNum = 1;
+    int address = 0;            /* address of the next instruction */
+    int last = 0;
+    InstrFields fields;
+    FieldBlock  block;          /* decoded, but not yet packed */
+    int         slots[PACK_BLOCK_SIZE];     /* where they go in the batch */
+    EncodeCache cache;          /* instructions already encoded */
+
+    cacheInit(&cache);
+    while ( ! last )
+    {
+        LineBatch * lines = spscPop(&pipe->fullLines);
+        WordBatch * words = spscPop(&pipe->freeWords);
+        int i;
+
+        /* Decode each line (unless it is in the cache), and pack the
+         * fields a block at a time.  Each instruction's place in the
+         * batch is reserved as it is found, so cached words and packed
+         * blocks stay in order.
+         */
+        words->numWords = 0;
+        block.count = 0;
+        for ( i = 0; i < lines->numLines; i++, lineNum++ )
+        {
+            int result;
+
+            result = cacheDecode(&cache, lines->text + lines->starts[i],
+                                 lineNum, address + 4, pipe->table, &fields,
+                                 &words->words[words->numWords], NULL);
+            address += addressStep(result);
+            if ( result == ASM_CACHED )
+                words->numWords++;
+            if ( result != ASM_OK )
+                continue;
+            slots[block.count] = words->numWords++;
+            blockAdd(&block, &fields);
+            if ( block.count == PACK_BLOCK_SIZE )
+                flushBlock(words, &block, slots);
+        }
+        flushBlock(words, &block, slots);
+
+        last = words->last = lines->last;
+        spscPush(&pipe->freeLines, lines);
+        spscPush(&pipe->fullWords, words);
+    }
+    cacheFree(&cache);
+    return NULL;
+}
+
+static void * writerStage(void * arg)
+{
+    Pipeline * pipe = arg;
+    static char output[LINES_PER_BATCH * MAX_WORD_LENGTH];
+    int length = outputWordLength();
+    int last = 0;
+
+    while ( ! last )
+    {
+        WordBatch * words = spscPop(&pipe->fullWords);
+        int i;
+
+        for ( i = 0; i < words->numWords; i++ )
+            formatWord(words->words[i], output + i * length);
+        fwrite(output, length, words->numWords, stdout);
+
+        last = words->last;
+        spscPush(&pipe->freeWords, words);
+    }
+    fflush(stdout);
+    return NULL;
+}
+
+int pass2Pipelined (FILE * fp, LabelTableArrayList * table)
+{
+    Pipeline  pipe;
+    LineBatch lineBatches[BATCHES_IN_FLIGHT];
+    WordBatch * wordBatches;
+    char    * text;
+    pthread_t reader, encoder, writer;
+    int       i, ok = 0;
+
+    memset(&pipe, 0, sizeof(pipe));
+    pipe.fp = fp;
+    pipe.table = table;
+
+    /* Allocate all batches up front. */
+    text = malloc(BATCHES_IN_FLIGHT * BATCH_TEXT_BYTES);
+    wordBatches = malloc(BATCHES_IN_FLIGHT * sizeof(WordBatch));
+    if ( text == NULL || wordBatches == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(text);
+        free(wordBatches);
+        return 0;
+    }
+    if ( ! spscInit(&pipe.fullLines, RING_CAPACITY) ||
+         ! spscInit(&pipe.freeLines, RING_CAPACITY) ||
+         ! spscInit(&pipe.fullWords, RING_CAPACITY) ||
+         ! spscInit(&pipe.freeWords, RING_CAPACITY) )
+        goto cleanup;
+
+    /* Every batch starts out empty, waiting in its free ring. */
+    for ( i = 0; i < BATCHES_IN_FLIGHT; i++ )
+    {
+        lineBatches[i].text = text + i * BATCH_TEXT_BYTES;
+        spscPush(&pipe.freeLines, &lineBatches[i]);
+        spscPush(&pipe.freeWords, &wordBatches[i]);
+    }
+
+    /* Start the writer and encoder first; they wait for input.  If the
+     * reader cannot be started, nothing has been read, so the caller
+     * can still fall back to pass2 -- but the waiting stages must be
+     * told that there is no input.  Reaching the error limit only ends
+     * the program once every stage has been joined (see holdErrorExit).
+     */
+    holdErrorExit();
+    if ( pthread_create(&writer, NULL, writerStage, &pipe) != 0 )
+        goto cleanup;
+    if ( pthread_create(&encoder, NULL, encoderStage, &pipe) != 0 )
+    {
+        WordBatch * words = spscPop(&pipe.freeWords);
+        words->numWords = 0;
+        words->last = 1;
+        spscPush(&pipe.fullWords, words);
+        pthread_join(writer, NULL);
+        goto cleanup;
+    }
+    if ( pthread_create(&reader, NULL, readerStage, &pipe) != 0 )
+    {
+        LineBatch * lines = spscPop(&pipe.freeLines);
+        lines->numLines = 0;
+        lines->last = 1;
+        spscPush(&pipe.fullLines, lines);
+        pthread_join(encoder, NULL);
+        pthread_join(writer, NULL);
+        goto cleanup;
+    }
+
+    pthread_join(reader, NULL);
+    pthread_join(encoder, NULL);
+    pthread_join(writer, NULL);
+    ok = 1;
+
+cleanup:
+    releaseErrorExit();
+    spscFree(&pipe.fullLines);
+    spscFree(&pipe.freeLines);
+    spscFree(&pipe.fullWords);
+    spscFree(&pipe.freeWords);
+    free(text);
+    free(wordBatches);
+    if ( ! ok )
+        printError("Error: cannot start the pass2 pipeline.\n");
+    return ok;
+}
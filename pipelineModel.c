@@ -0,0 +1,265 @@
+/**
+ * void modelPipeline (const Image * image, LabelTableArrayList * table,
+ *                     FILE * out)
+ *      @param  image  the assembled program
+ *      @param  table  its labels
+ *      @param  out  where to write the report
+ *
+ * This function estimates how the program would run on the classic
+ * 5-stage MIPS pipeline (IF, ID, EX, MEM, WB), without running it.  It
+ * walks the instructions in order, as though each ran once, and finds:
+ *
+ *      - forwarding: a result is forwarded from the EX/MEM or MEM/WB
+ *        pipeline register to the instruction that needs it, or read
+ *        from the register file, which is written in the first half of
+ *        WB and read in the second half of ID;
+ *      - load-use stalls: a loaded value is ready only after MEM, so an
+ *        instruction that uses it in EX right after the lw waits a cycle
+ *        (a sw that only stores it gets it in MEM, without waiting);
+ *      - branch data stalls: branches (and jr) compare or read their
+ *        registers in ID, so they wait a cycle for a result computed
+ *        just before them, and two for a value loaded just before;
+ *      - control penalties: a branch or jump is resolved in ID, so the
+ *        instruction fetched after it is thrown away if it is taken.
+ *        Jumps are always taken; branches are predicted statically,
+ *        backward ones (loops) taken and forward ones not.
+ *
+ * Straight-line order is followed across labels, but not past an
+ * unconditional jump, since the next instruction is not what runs next.
+ *
+ * The program is divided into basic blocks, each starting at address 0,
+ * at a label, at the target of a branch or jump, or after a branch or
+ * jump.  The report gives each block's stalls, penalties, cycles, and
+ * CPI, then the totals, including the 4 cycles it takes to fill the
+ * pipeline, and the number of values forwarded along each path.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "image.h"
+#include "instrInfo.h"
+
+#define NUM_REGS   34           /* 32 registers, HI, and LO */
+#define LONG_AGO   -100L        /* EX cycle of a value already written */
+
+/* Forwarding paths. */
+enum { EXMEM_TO_EX, MEMWB_TO_EX, EXMEM_TO_ID, MEMWB_TO_MEM, NUM_PATHS };
+
+static const char * PATH_NAMES[NUM_PATHS] = {
+    "EX/MEM->EX", "MEM/WB->EX", "EX/MEM->ID", "MEM/WB->MEM"
+};
+
+/* Totals for a block, or for the program. */
+typedef struct {
+        long instructions;
+        long loadUse;           /* load-use stall cycles */
+        long branchData;        /* branch data stall cycles */
+        long control;           /* control penalty cycles */
+} Counts;
+
+static void addCounts(Counts * total, const Counts * counts)
+{
+    total->instructions += counts->instructions;
+    total->loadUse += counts->loadUse;
+    total->branchData += counts->branchData;
+    total->control += counts->control;
+}
+
+static long countCycles(const Counts * counts)
+{
+    return counts->instructions + counts->loadUse + counts->branchData +
+           counts->control;
+}
+
+/* Writes one block's line of the report. */
+static void reportBlock(FILE * out, int block, long address, int lineNum,
+                        const char * label, const Counts * counts)
+{
+    long cycles = countCycles(counts);
+
+    fprintf(out, "%5d %8ld %6d  %-16s %7ld %8ld %11ld %7ld %7ld %6.2f\n",
+            block, address, lineNum, label != NULL ? label : "",
+            counts->instructions, counts->loadUse, counts->branchData,
+            counts->control, cycles, (double) cycles / counts->instructions);
+}
+
+void modelPipeline (const Image * image, LabelTableArrayList * table,
+                    FILE * out)
+{
+    long          numWords = image->numWords;
+    char        * leader = calloc(numWords + 1, 1);
+    const char ** labels = calloc(numWords + 1, sizeof(char *));
+    long          readyEx[NUM_REGS];    /* EX cycle of each register's
+                                           last producer */
+    char          loaded[NUM_REGS];     /* was it a load? */
+    long          forwards[NUM_PATHS];
+    long          ex = 1;               /* EX cycle of the last instruction */
+    long          penalty = 0;          /* bubbles after it */
+    Counts        block, total;
+    long          i, blockStart = 0;
+    int           numBlocks = 0, r;
+    InstrInfo     info;
+
+    if ( leader == NULL || labels == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(leader);
+        free(labels);
+        return;
+    }
+
+    /* Find the first instruction of each basic block, and the label (the
+     * first one defined) at each address.
+     */
+    leader[0] = 1;
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        long address = table->addresses[i];
+
+        if ( address >= 0 && address % 4 == 0 && address / 4 < numWords )
+        {
+            leader[address / 4] = 1;
+            if ( labels[address / 4] == NULL )
+                labels[address / 4] = tableLabelName(table, (int) i);
+        }
+    }
+    for ( i = 0; i < numWords; i++ )
+    {
+        instrInfo(image->words[i], 4 * i, &info);
+        if ( info.flags & (INFO_BRANCH | INFO_JUMP) )
+            leader[i + 1] = 1;
+        if ( info.target >= 0 && info.target % 4 == 0 &&
+             info.target / 4 < numWords )
+            leader[info.target / 4] = 1;
+    }
+
+    fprintf(out, "Pipeline model: IF ID EX MEM WB, full forwarding, "
+            "branches resolved in ID,\nbackward branches predicted taken."
+            "\n\n");
+    fprintf(out, "%5s %8s %6s  %-16s %7s %8s %11s %7s %7s %6s\n", "block",
+            "address", "line", "label", "instrs", "load-use", "branch-data",
+            "control", "cycles", "CPI");
+
+    for ( r = 0; r < NUM_REGS; r++ )
+    {
+        readyEx[r] = LONG_AGO;
+        loaded[r] = 0;
+    }
+    memset(forwards, 0, sizeof(forwards));
+    memset(&block, 0, sizeof(block));
+    memset(&total, 0, sizeof(total));
+
+    for ( i = 0; i < numWords; i++ )
+    {
+        unsigned int word = image->words[i];
+        long         earliest, need;
+        int          store;
+        unsigned int storeData;
+
+        if ( leader[i] && i > 0 )
+        {
+            reportBlock(out, ++numBlocks, 4 * blockStart,
+                        image->lineNums[blockStart], labels[blockStart],
+                        &block);
+            addCounts(&total, &block);
+            memset(&block, 0, sizeof(block));
+            blockStart = i;
+        }
+        instrInfo(word, 4 * i, &info);
+        store = (info.flags & INFO_STORE) != 0;
+        storeData = (word >> 16) & 0x1F;
+
+        /* When could this instruction be in EX, and when must it be,
+         * given what it reads?
+         */
+        earliest = ex + 1 + penalty;
+        need = earliest;
+        for ( r = 1; r < NUM_REGS; r++ )
+        {
+            long ready;
+
+            if ( ! (info.reads & REG_BIT(r)) )
+                continue;
+            if ( info.flags & (INFO_BRANCH | INFO_INDIRECT) )
+                ready = readyEx[r] + (loaded[r] ? 3 : 2);   /* in ID */
+            else if ( store && r == (int) storeData && loaded[r] )
+                ready = readyEx[r] + 1;                     /* in MEM */
+            else
+                ready = readyEx[r] + (loaded[r] ? 2 : 1);   /* in EX */
+            if ( ready > need )
+                need = ready;
+        }
+        if ( need > earliest )
+        {
+            if ( info.flags & (INFO_BRANCH | INFO_INDIRECT) )
+                block.branchData += need - earliest;
+            else
+                block.loadUse += need - earliest;
+        }
+        ex = need;
+
+        /* How did each value get here? */
+        for ( r = 1; r < NUM_REGS; r++ )
+        {
+            long gap = ex - readyEx[r];
+
+            if ( ! (info.reads & REG_BIT(r)) )
+                continue;
+            if ( info.flags & (INFO_BRANCH | INFO_INDIRECT) )
+            {
+                if ( gap == 2 && ! loaded[r] )
+                    forwards[EXMEM_TO_ID]++;
+            }
+            else if ( store && r == (int) storeData && loaded[r] )
+            {
+                if ( gap == 1 )
+                    forwards[MEMWB_TO_MEM]++;
+            }
+            else if ( gap == 1 )
+                forwards[EXMEM_TO_EX]++;
+            else if ( gap == 2 )
+                forwards[MEMWB_TO_EX]++;
+        }
+
+        for ( r = 1; r < NUM_REGS; r++ )
+            if ( info.writes & REG_BIT(r) )
+            {
+                readyEx[r] = ex;
+                loaded[r] = (info.flags & INFO_LOAD) != 0;
+            }
+
+        /* A taken branch or jump throws away the instruction fetched
+         * after it.  Past an unconditional jump, straight-line order is
+         * not what runs, so nothing is waited for there.
+         */
+        penalty = (info.flags & INFO_JUMP) ||
+                  ((info.flags & INFO_BRANCH) && info.target <= 4 * i);
+        block.control += penalty;
+        if ( info.flags & INFO_JUMP )
+            for ( r = 0; r < NUM_REGS; r++ )
+                readyEx[r] = LONG_AGO;
+        block.instructions++;
+    }
+    if ( numWords > 0 )
+    {
+        reportBlock(out, ++numBlocks, 4 * blockStart,
+                    image->lineNums[blockStart], labels[blockStart], &block);
+        addCounts(&total, &block);
+    }
+
+    fprintf(out, "\ntotal: %ld instructions in %d blocks; %ld load-use "
+            "stalls, %ld branch data stalls,\n%ld control penalty cycles, "
+            "4 fill cycles; %ld cycles, CPI %.2f\n", total.instructions,
+            numBlocks, total.loadUse, total.branchData, total.control,
+            countCycles(&total) + 4, total.instructions > 0 ?
+            (double) (countCycles(&total) + 4) / total.instructions : 0.0);
+    fprintf(out, "forwarding:");
+    for ( r = 0; r < NUM_PATHS; r++ )
+        fprintf(out, "%s %ld %s", r == 0 ? "" : ",", forwards[r],
+                PATH_NAMES[r]);
+    fprintf(out, "\n");
+
+    free(leader);
+    free(labels);
+}
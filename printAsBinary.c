@@ -21,8 +21,20 @@
  *    - AB, 3/25/2020 - implement printIntInString, stub printInt,
  *                      provide skeletons for others
  *    - TR, 3/2/2022  - Implement printInt, printReg, printJumpTarget, and printBranchOffset.
+ *    - 10/19/2026    - Split out getRegNum, getIntInString, getJumpTarget,
+ *                      and getBranchOffset, which return the values the
+ *                      print functions print, so that instructions can be
+ *                      encoded as 32-bit words; added formatBinaryWord.
+ *    - 10/19/2026    - Added the raw and hex output formats (formatWord,
+ *                      setOutputFormat).
+ *    - 10/19/2026    - printReg and printIntInString use parseOperand,
+ *                      so there is one table of register names; removed
+ *                      getRegNum and getIntInString.
  */
 
+/* The output format chosen with setOutputFormat. */
+static int outputFormat = FORMAT_BINARY;
+
 /* Print integer value in pseudo-binary (made up of character '0's and '1's).
  *      @param value   value to print in pseudo-binary
  *      @param length  length of binary code needed, in bits
@@ -60,85 +72,19 @@ void printInt(int value, int length)
  *      @param regName   name of register to print in pseudo-binary
  *      @param lineNum   line number (for error messages)
  * If the register name passed as a parameter is an invalid register name,
- * this function prints "<invalid reg>" instead of the register number,
+ * this function prints an error message instead of the register number,
  * allowing the rest of the instruction to be parsed and printed.
  */
 void printReg(char * regName, int lineNum)
 {
-    int regNum; 
-    if ( strcmp(regName, "$zero") == SAME )
-        regNum = 0;
-    else if ( strcmp(regName, "$at") == SAME )
-        regNum = 1;
-    else if ( strcmp(regName, "$v0") == SAME )
-        regNum = 2;
-    else if ( strcmp(regName, "$v1") == SAME )
-        regNum = 3;
-    else if ( strcmp(regName, "$a0") == SAME )
-        regNum = 4;
-    else if ( strcmp(regName, "$a1") == SAME )
-        regNum = 5;
-    else if ( strcmp(regName, "$a2") == SAME )
-        regNum = 6;
-    else if ( strcmp(regName, "$a3") == SAME )
-        regNum = 7;
-    else if ( strcmp(regName, "$t0") == SAME )
-        regNum = 8;
-    else if ( strcmp(regName, "$t1") == SAME )
-        regNum = 9;
-    else if ( strcmp(regName, "$t2") == SAME )
-        regNum = 10;
-    else if ( strcmp(regName, "$t3") == SAME )
-        regNum = 11;
-    else if ( strcmp(regName, "$t4") == SAME )
-        regNum = 12;
-    else if ( strcmp(regName, "$t5") == SAME )
-        regNum = 13;
-    else if ( strcmp(regName, "$t6") == SAME )
-        regNum = 14;
-    else if ( strcmp(regName, "$t7") == SAME )
-        regNum = 15;
-    else if ( strcmp(regName, "$s0") == SAME )
-        regNum = 16;
-    else if ( strcmp(regName, "$s1") == SAME )
-        regNum = 17;
-    else if ( strcmp(regName, "$s2") == SAME )
-        regNum = 18;
-    else if ( strcmp(regName, "$s3") == SAME )
-        regNum = 19;
-    else if ( strcmp(regName, "$s4") == SAME )
-        regNum = 20;
-    else if ( strcmp(regName, "$s5") == SAME )
-        regNum = 21;
-    else if ( strcmp(regName, "$s6") == SAME )
-        regNum = 22;
-    else if ( strcmp(regName, "$s7") == SAME )
-        regNum = 23;
-    else if ( strcmp(regName, "$t8") == SAME )
-        regNum = 24;
-    else if ( strcmp(regName, "$t9") == SAME )
-        regNum = 25;
-    else if ( strcmp(regName, "$k0") == SAME )
-        regNum = 26;
-    else if ( strcmp(regName, "$k1") == SAME )
-        regNum = 27;
-    else if ( strcmp(regName, "$gp") == SAME )
-        regNum = 28;
-    else if ( strcmp(regName, "$sp") == SAME )
-        regNum = 29;
-    else if ( strcmp(regName, "$fp") == SAME )
-        regNum = 30;
-    else if ( strcmp(regName, "$ra") == SAME )
-        regNum = 31;
-    else 
-        {printError("Line: %d. This register %s is invalid.\n", lineNum, regName);
-        regNum = -1;}
-
-
-    if (regNum != -1)
-        printInt(regNum, 5);
-
+    Operand operand;
 
+    if ( parseOperand(regName, &operand) &&
+         operand.kind == OPERAND_REGISTER )
+        printInt((int) operand.value, 5);
+    else
+        printError("Line: %d. This register %s is invalid.\n", lineNum,
+                   regName);
 }
 
 
@@ -153,24 +99,17 @@ void printReg(char * regName, int lineNum)
  */
 void printIntInString(char * intInString, int numBits, int lineNum)
 {
-    char * endPtr;
-
-    /* Convert string to decimal (base 10) value. */
-    int decimal = (int) strtol(intInString, &endPtr, 10);
+    Operand operand;
 
-    /* If the string contained a valid int, print it;
-     * otherwise print an error message.
+    /* If the string contained a valid int, print it (otherwise print an
+     * error message).
      */
-    if ( *intInString != '\0' && *endPtr == '\0' )
-    {
-        /* entire string was valid */
-        printInt(decimal, numBits);
-    }
+    if ( parseOperand(intInString, &operand) &&
+         operand.kind == OPERAND_NUMBER )
+        printInt((int) operand.value, numBits);
     else
-    {
         printError("Line %d: trying to print %s as an int (%s).\n",
-                lineNum, intInString, "not a valid integer");
-    }
+                   lineNum, intInString, "not a valid integer");
 }
 
 
@@ -187,13 +126,36 @@ void printIntInString(char * intInString, int numBits, int lineNum)
 void printJumpTarget(char * targetLabel, LabelTableArrayList * table,
                      int lineNum)
 {
-    
+    int address;
+
+    if ( getJumpTarget(targetLabel, table, lineNum, &address) )
+        printInt(address, 26);
+}
+
+
+/* Get the value to store in the 26-bit target field of a jump.
+ *      @param targetLabel   label being jumped to
+ *      @param table         label table
+ *      @param lineNum       line number (for error messages)
+ *      @param target        address where the value should be placed
+ *      @return              1 if the label was found; 0 (after printing
+ *                           an error message) otherwise
+ */
+int getJumpTarget(char * targetLabel, LabelTableArrayList * table,
+                  int lineNum, int * target)
+{
     int address = findLabelAddr(table, targetLabel);
-    address = address/4; //shift it down by 2 or divide by 4 to account for int size
 
-    printDebug("\n jump address: %d. on line %d.\n", address, lineNum);
-    printInt(address, 26);
+    if ( address == -1 )
+    {
+        printError("Line %d: label %s is not defined.\n", lineNum,
+                   targetLabel);
+        return 0;
+    }
 
+    *target = address/4; //shift it down by 2 or divide by 4 to account for int size
+    printDebug("\n jump address: %d. on line %d.\n", *target, lineNum);
+    return 1;
 }
 
 /* Print branch offset to branch to the target label.
@@ -205,12 +167,118 @@ void printJumpTarget(char * targetLabel, LabelTableArrayList * table,
 void printBranchOffset(char * targetLabel, LabelTableArrayList * table,
                        int PC, int lineNum)
 {
+    int offset;
+
+    if ( getBranchOffset(targetLabel, table, PC, lineNum, &offset) )
+        printInt(offset, 16);
+}
+
 
+/* Get the value to store in the 16-bit offset field of a branch.
+ *      @param targetLabel   label being branched to
+ *      @param table         label table
+ *      @param PC            Program Counter (address of the instruction
+ *                           after the branch)
+ *      @param lineNum       line number (for error messages)
+ *      @param offset        address where the offset (in instructions,
+ *                           possibly negative) should be placed
+ *      @return              1 if the label was found; 0 (after printing
+ *                           an error message) otherwise
+ */
+int getBranchOffset(char * targetLabel, LabelTableArrayList * table,
+                    int PC, int lineNum, int * offset)
+{
     int address = findLabelAddr(table, targetLabel);
-    address = (address-PC)/4;
 
-    printDebug("\n branch address: %d. PC: %d. on line %d.\n", address, PC, lineNum);
+    if ( address == -1 )
+    {
+        printError("Line %d: label %s is not defined.\n", lineNum,
+                   targetLabel);
+        return 0;
+    }
+
+    *offset = (address-PC)/4;
+    printDebug("\n branch address: %d. PC: %d. on line %d.\n", *offset, PC, lineNum);
+    return 1;
+}
+
+
+/* Format a 32-bit instruction as pseudo-binary: 32 character '0's and
+ * '1's followed by a newline.
+ *      @param word    the instruction
+ *      @param buffer  where to put the BINARY_WORD_LENGTH characters
+ *                     (no null byte is added)
+ */
+void formatBinaryWord(unsigned int word, char * buffer)
+{
+    int bit;
+
+    for ( bit = 0; bit < 32; bit++ )
+        buffer[bit] = '0' + ((word >> (31 - bit)) & 1);
+    buffer[32] = '\n';
+}
 
-    printInt(address, 16);
+/* Choose the format in which formatWord formats instructions.
+ *      @param format  FORMAT_BINARY (pseudo-binary, the default),
+ *                     FORMAT_RAW (4 bytes, most significant first), or
+ *                     FORMAT_HEX (8 hex digits and a newline)
+ */
+void setOutputFormat(int format)
+{
+    outputFormat = format;
+}
 
+/* Find the output format with the given name ("binary", "raw", or
+ * "hex").  Returns the format, or -1 if there is no such format.
+ */
+int findOutputFormat(const char * name)
+{
+    if ( strcmp(name, "binary") == SAME )
+        return FORMAT_BINARY;
+    if ( strcmp(name, "raw") == SAME )
+        return FORMAT_RAW;
+    if ( strcmp(name, "hex") == SAME )
+        return FORMAT_HEX;
+    return -1;
+}
+
+/* Returns the number of bytes formatWord produces for each instruction
+ * in the current output format.  Every instruction has the same width,
+ * so the place of an instruction's output is known from its index.
+ */
+int outputWordLength(void)
+{
+    if ( outputFormat == FORMAT_RAW )
+        return RAW_WORD_LENGTH;
+    if ( outputFormat == FORMAT_HEX )
+        return HEX_WORD_LENGTH;
+    return BINARY_WORD_LENGTH;
+}
+
+/* Format an instruction in the current output format.
+ *      @param word    the instruction
+ *      @param buffer  where to put the outputWordLength() bytes (at most
+ *                     MAX_WORD_LENGTH; no null byte is added)
+ *      @return        the number of bytes placed in buffer
+ */
+int formatWord(unsigned int word, char * buffer)
+{
+    static const char digits[] = "0123456789abcdef";
+    int i;
+
+    if ( outputFormat == FORMAT_RAW )
+    {
+        for ( i = 0; i < 4; i++ )
+            buffer[i] = (char) (word >> (24 - 8 * i));
+        return RAW_WORD_LENGTH;
+    }
+    if ( outputFormat == FORMAT_HEX )
+    {
+        for ( i = 0; i < 8; i++ )
+            buffer[i] = digits[(word >> (28 - 4 * i)) & 0xF];
+        buffer[8] = '\n';
+        return HEX_WORD_LENGTH;
+    }
+    formatBinaryWord(word, buffer);
+    return BINARY_WORD_LENGTH;
 }
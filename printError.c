@@ -1,4 +1,5 @@
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include "printFuncs.h"
@@ -6,6 +7,13 @@
 /** Define the global ERROR_LIMIT variable. **/
 int ERROR_LIMIT = 20;
 
+/* The number of errors printed so far, and whether the program is in
+ * a section run by several threads (see holdErrorExit).  Both may be
+ * touched by several threads at once.
+ */
+static atomic_int error_count = 0;
+static atomic_int exit_held = 0;
+
 /**
  * printError(const char * restrict_format, ...)
  *
@@ -28,10 +36,25 @@ int ERROR_LIMIT = 20;
  * Exit Value:
  *  If ERROR_LIMIT is greater than zero and the program has reached the
  *  limit, printError will exit the program with an error code of 1.
+ *  Between calls to holdErrorExit and releaseErrorExit, it prints no
+ *  more messages after the one that passes the limit, and leaves the
+ *  exit to releaseErrorExit.
+ *
+ * Modified: 10/19/2026
+ *  The error count is atomic, since threads may print errors at the
+ *  same time; holdErrorExit and releaseErrorExit keep those threads
+ *  from exiting while others are still running.
  */
 void printError(const char * restrict_format, ...)
 {
-    static int error_count = 0;
+    int held = atomic_load(&exit_held);
+    int count = atomic_fetch_add(&error_count, 1) + 1;
+
+    /* Past the limit, a thread that may not exit prints nothing more. */
+    if ( held && ERROR_LIMIT > 0 && count > ERROR_LIMIT + 1 )
+    {
+        return;
+    }
 
     /* The following code allows us to call fprintf with the variable
      * parameters that were passed to printError.
@@ -41,11 +64,45 @@ void printError(const char * restrict_format, ...)
     (void) vfprintf(stderr, restrict_format, ap);
     va_end(ap);
 
-    /* Keep track of the error count, and exit if it goes too high. */
-    error_count++;
-    if ( ERROR_LIMIT > 0 && error_count > ERROR_LIMIT )
+    /* Exit if the error count has gone too high. */
+    if ( ERROR_LIMIT > 0 && count > ERROR_LIMIT && ! held )
     {
         exit(1);
     }
 
 }
+
+/**
+ * holdErrorExit()
+ *
+ * This function stops printError from exiting the program, until
+ * releaseErrorExit is called.  It is called by the main thread before
+ * it starts threads that may print errors, since exiting from one of
+ * them would end the program while the others are still writing its
+ * output.
+ */
+void holdErrorExit(void)
+{
+    atomic_store(&exit_held, 1);
+}
+
+/**
+ * releaseErrorExit()
+ *
+ * This function lets printError exit the program again.  It is called
+ * by the main thread after it has joined the threads it started after
+ * calling holdErrorExit.
+ *
+ * Exit Value:
+ *  If ERROR_LIMIT is greater than zero and more errors than that have
+ *  been reported, releaseErrorExit exits the program with an error code
+ *  of 1, as printError would have done.
+ */
+void releaseErrorExit(void)
+{
+    atomic_store(&exit_held, 0);
+    if ( ERROR_LIMIT > 0 && atomic_load(&error_count) > ERROR_LIMIT )
+    {
+        exit(1);
+    }
+}
@@ -12,6 +12,13 @@
  *      to change the number of errors that get printed before the
  *      programs stops execution.
  *
+ * holdErrorExit keeps printError from stopping execution (it stops
+ *      printing instead), so that threads which print errors cannot
+ *      end the program while others are still running.
+ *
+ * releaseErrorExit undoes holdErrorExit, once those threads have been
+ *      joined, and stops execution if the error limit was passed.
+ *
  * printDebug will print a debugging message to stdout, but only if
  *      debugging has been turned on.
  *      printDebug takes a variable number of arguments, the first of
@@ -48,6 +55,9 @@ void printError(const char * restrict_format, ...);
 
 extern int ERROR_LIMIT;
 
+void holdErrorExit(void);
+void releaseErrorExit(void);
+
 void printDebug(const char * restrict_format, ...);
 
 void debug_on(void);
@@ -0,0 +1,206 @@
+/*
+ * Program: functions to read an assembly source into memory and encode
+ * its lines.
+ *
+ * See program.h for a description of a program.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "program.h"
+#include "encodeCache.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+static const char * ERROR = "Error: cannot allocate space in memory.\n";
+
+/* Reads the rest of fp into a malloc'ed buffer.  Returns 1 if everything
+ * went OK; 0 if memory allocation error.
+ */
+static int readText(Program * program, FILE * fp)
+{
+    size_t capacity = 64 * 1024;
+    size_t numRead;
+
+    if ( (program->text = malloc(capacity)) == NULL )
+        return 0;
+    while ( (numRead = fread(program->text + program->size, 1,
+                             capacity - program->size, fp)) > 0 )
+    {
+        program->size += numRead;
+        if ( program->size == capacity )
+        {
+            char * text = realloc(program->text, capacity *= 2);
+            if ( text == NULL )
+                return 0;
+            program->text = text;
+        }
+    }
+    return 1;
+}
+
+/* Splits the text into lines as fgets would.  Returns 1 if everything
+ * went OK; 0 if memory allocation error.
+ */
+static int indexLines(Program * program)
+{
+    size_t start = 0;
+    int    capacity = 1024;
+
+    if ( (program->lineStarts = malloc(capacity * sizeof(size_t))) == NULL )
+        return 0;
+
+    while ( start < program->size )
+    {
+        size_t maxLength = program->size - start;
+        char * newline;
+
+        if ( maxLength > BUFSIZ - 1 )
+            maxLength = BUFSIZ - 1;
+        newline = memchr(program->text + start, '\n', maxLength);
+
+        if ( program->numLines + 1 >= capacity )
+        {
+            size_t * starts = realloc(program->lineStarts,
+                                      (capacity *= 2) * sizeof(size_t));
+            if ( starts == NULL )
+                return 0;
+            program->lineStarts = starts;
+        }
+        program->lineStarts[program->numLines++] = start;
+        start = newline != NULL ? (size_t) (newline - program->text) + 1
+                                : start + maxLength;
+    }
+    program->lineStarts[program->numLines] = program->size;
+    return 1;
+}
+
+int programRead (Program * program, FILE * fp)
+{
+    struct stat info;
+    long        offset = ftell(fp);
+
+    memset(program, 0, sizeof(Program));
+
+    /* Map a regular file (from the current position on) into memory;
+     * read anything else.
+     */
+    if ( offset >= 0 && fstat(fileno(fp), &info) == 0 &&
+         S_ISREG(info.st_mode) && info.st_size > offset )
+    {
+        char * map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE,
+                          fileno(fp), 0);
+        if ( map != MAP_FAILED )
+        {
+            program->map = map;
+            program->mapSize = info.st_size;
+            program->text = map + offset;
+            program->size = info.st_size - offset;
+        }
+    }
+    if ( program->map == NULL && ! readText(program, fp) )
+    {
+        printError("%s", ERROR);
+        programFree(program);
+        return 0;
+    }
+
+    if ( ! indexLines(program) ||
+         (program->words = malloc((program->numLines + 1) *
+                                  sizeof(unsigned int))) == NULL ||
+         (program->status = malloc(program->numLines + 1)) == NULL )
+    {
+        printError("%s", ERROR);
+        programFree(program);
+        return 0;
+    }
+    return 1;
+}
+
+size_t programEstimate (size_t inputBytes, long numLines)
+{
+    /* The text, plus a line start, word, and status for each line. */
+    return inputBytes + (size_t) (numLines + 1) *
+           (sizeof(size_t) + sizeof(unsigned int) + sizeof(signed char));
+}
+
+int programAddress (const Program * program, int first, int last)
+{
+    int size = 0;
+    int line;
+
+    for ( line = first; line < last; line++ )
+        size += instructionSize(program->text + program->lineStarts[line],
+                                program->lineStarts[line + 1] -
+                                program->lineStarts[line]);
+    return size;
+}
+
+/* Packs the instructions in block and stores them as the words of the
+ * lines they came from; empties the block.
+ */
+static void flushBlock(Program * program, FieldBlock * block,
+                       const int * lines)
+{
+    unsigned int words[PACK_BLOCK_SIZE];
+    int          i;
+
+    packBlock(block, words);
+    for ( i = 0; i < block->count; i++ )
+        program->words[lines[i]] = words[i];
+    block->count = 0;
+}
+
+void programEncode (Program * program, LabelTableArrayList * table,
+                    int first, int last, int address)
+{
+    char        inst[BUFSIZ];   /* decodeLine modifies its line */
+    InstrFields fields;
+    FieldBlock  block;          /* decoded, but not yet packed */
+    int         blockLines[PACK_BLOCK_SIZE];    /* where they came from */
+    EncodeCache cache;          /* instructions already encoded */
+    int         line, result;
+
+    cacheInit(&cache);
+    block.count = 0;
+    for ( line = first; line < last; line++ )
+    {
+        size_t length = program->lineStarts[line + 1] -
+                        program->lineStarts[line];
+
+        memcpy(inst, program->text + program->lineStarts[line], length);
+        inst[length] = '\0';
+
+        /* Line numbers start at 1; the PC is the next instruction's
+         * address.  An instruction found in the cache needs no packing.
+         */
+        result = cacheDecode(&cache, inst, line + 1, address + 4, table,
+                             &fields, &program->words[line], NULL);
+        address += addressStep(result);
+        program->status[line] = result == ASM_CACHED ? ASM_OK : result;
+        if ( result != ASM_OK )
+            continue;
+
+        /* Pack the fields a block at a time. */
+        blockLines[block.count] = line;
+        blockAdd(&block, &fields);
+        if ( block.count == PACK_BLOCK_SIZE )
+            flushBlock(program, &block, blockLines);
+    }
+    flushBlock(program, &block, blockLines);
+    cacheFree(&cache);
+}
+
+void programFree (Program * program)
+{
+    if ( program->map != NULL )
+        munmap(program->map, program->mapSize);
+    else
+        free(program->text);
+    free(program->lineStarts);
+    free(program->words);
+    free(program->status);
+    memset(program, 0, sizeof(Program));
+}
@@ -0,0 +1,78 @@
+/*
+ * Program: the whole assembly source held in memory.
+ *
+ * A program holds the text of the source, an index of where each line
+ * starts, and, once it has been encoded, the machine code (and the
+ * result of encoding) for each line.  Because every line can be found
+ * directly, any range of lines can be encoded independently of the
+ * others -- for example, by different threads -- once the address of
+ * its first line is known (see programAddress).
+ *
+ * Lines are split exactly as fgets(line, BUFSIZ, fp) would split them
+ * (a line longer than BUFSIZ - 1 characters becomes several lines), so
+ * line numbers and addresses agree with pass1 and pass2.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _PROGRAM_H
+#define _PROGRAM_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "LabelTableArrayList.h"
+
+/* THE DATA STRUCTURE */
+
+typedef struct {
+        char   * text;          /* the source (not null-terminated) */
+        size_t   size;          /* bytes of text */
+        void   * map;           /* the mapped file holding text, or NULL
+                                   if text is malloc'ed */
+        size_t   mapSize;       /* bytes mapped */
+        size_t * lineStarts;    /* where each line starts in text, plus
+                                   one more entry for the end of text */
+        int      numLines;
+        unsigned int * words;   /* the machine code for each line */
+        signed char  * status;  /* ASM_OK, ASM_NONE, or ASM_ERROR for
+                                   each line (see assembleLine) */
+} Program;
+
+
+/* THE FUNCTIONS */
+
+int programRead (Program * program, FILE * fp);
+        /* Postcondition: program holds the rest of the input in fp
+         *      (mapped into memory if fp is a regular file, read
+         *      otherwise), split into lines; no line is encoded yet.
+         * Returns 1 if everything went OK; 0 if an error occurred (an
+         *      error message has been printed and program is empty).
+         */
+
+size_t programEstimate (size_t inputBytes, long numLines);
+        /* Returns about how many bytes a program read from inputBytes
+         *      bytes of input with numLines lines would occupy.
+         */
+
+int programAddress (const Program * program, int first, int last);
+        /* Returns the number of bytes lines first through last - 1
+         *      (numbered from 0) take up in the program (see
+         *      instructionSize), e.g., the address of line last if
+         *      first is 0.
+         */
+
+void programEncode (Program * program, LabelTableArrayList * table,
+                    int first, int last, int address);
+        /* Precondition: table holds every label in the program, and
+         *      address is the address of line first.
+         * Postcondition: lines first through last - 1 (numbered from 0)
+         *      have been encoded.  Different ranges of lines may be
+         *      encoded at the same time by different threads.
+         */
+
+void programFree (Program * program);
+        /* Postcondition: the memory used by program has been released.
+         */
+
+#endif
@@ -0,0 +1,302 @@
+/*
+ * Run: functions to decode an assembled program into Ops and to run it.
+ *
+ * See run.h for a description of the machine and of an Op.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "run.h"
+
+#include <time.h>
+
+/* Why a run stopped. */
+enum { STOP_END, STOP_STEPS, STOP_UNSUPPORTED, STOP_OUTSIDE, STOP_MEMORY };
+
+#define NO_REGISTER 32          /* stands in for $zero as a destination */
+
+static const char * REGISTER_NAMES[32] = {
+    "$zero", "$at", "$v0", "$v1", "$a0", "$a1", "$a2", "$a3",
+    "$t0", "$t1", "$t2", "$t3", "$t4", "$t5", "$t6", "$t7",
+    "$s0", "$s1", "$s2", "$s3", "$s4", "$s5", "$s6", "$s7",
+    "$t8", "$t9", "$k0", "$k1", "$gp", "$sp", "$fp", "$ra"
+};
+
+void runConfigInit (RunConfig * config)
+{
+    memset(config, 0, sizeof(RunConfig));
+    config->memorySize = RUN_DEFAULT_MEMORY;
+}
+
+/* Returns the kind of Op for word, a supported instruction. */
+static int opKind(unsigned int word)
+{
+    switch ( word >> 26 )
+    {
+        case 0:
+            switch ( word & 0x3F )
+            {
+                case 0:  return OP_SLL;
+                case 2:  return OP_SRL;
+                case 8:  return OP_JR;
+                case 32: return OP_ADD;
+                case 34: return OP_SUB;
+                case 36: return OP_AND;
+                case 37: return OP_OR;
+                case 39: return OP_NOR;
+                case 42: return OP_SLT;
+            }
+            break;
+        case 2:  return OP_J;
+        case 3:  return OP_JAL;
+        case 4:  return OP_BEQ;
+        case 5:  return OP_BNE;
+        case 8:  return OP_ADDI;
+        case 12: return OP_ANDI;
+        case 13: return OP_ORI;
+        case 15: return OP_LUI;
+        case 35: return OP_LW;
+        case 43: return OP_SW;
+    }
+    return OP_UNSUPPORTED;
+}
+
+/* Decodes the word at index i of a program of numWords words.  Branch
+ * and jump targets become instruction indexes; one outside the program
+ * becomes numWords + 1, where an OP_OUTSIDE waits.
+ */
+static void decodeOp(Op * op, unsigned int word, long i, long numWords)
+{
+    unsigned int rs = (word >> 21) & 0x1F, rt = (word >> 16) & 0x1F,
+                 rd = (word >> 11) & 0x1F;
+    long         target = -1;
+
+    op->kind = (unsigned char) (decodeTemplate(word) == NULL ?
+                                OP_UNSUPPORTED : opKind(word));
+    op->rs = (unsigned char) rs;
+    op->rt = (unsigned char) rt;
+    op->rd = NO_REGISTER;
+    op->imm = 0;
+    switch ( op->kind )
+    {
+        case OP_ADD: case OP_SUB: case OP_AND: case OP_OR: case OP_NOR:
+        case OP_SLT:
+            op->rd = (unsigned char) rd;
+            break;
+        case OP_SLL: case OP_SRL:
+            op->rd = (unsigned char) rd;
+            op->imm = (word >> 6) & 0x1F;
+            break;
+        case OP_ADDI: case OP_LW: case OP_SW:
+            op->rd = (unsigned char) (op->kind == OP_SW ? NO_REGISTER : rt);
+            op->imm = (short) (word & 0xFFFF);
+            break;
+        case OP_ANDI: case OP_ORI: case OP_LUI:
+            op->rd = (unsigned char) rt;
+            op->imm = (int) (word & 0xFFFF);
+            break;
+        case OP_BEQ: case OP_BNE:
+            target = i + 1 + (short) (word & 0xFFFF);
+            break;
+        case OP_J: case OP_JAL:
+            target = ((((i + 1) * 4) & 0xF0000000L) |
+                      (long) (word & 0x3FFFFFF) << 2) / 4;
+            if ( op->kind == OP_JAL )
+                op->rd = 31;
+            break;
+    }
+    if ( op->kind == OP_BEQ || op->kind == OP_BNE || op->kind == OP_J ||
+         op->kind == OP_JAL )
+        op->imm = (int) (target >= 0 && target <= numWords ? target
+                                                           : numWords + 1);
+    if ( op->rd == 0 )
+        op->rd = NO_REGISTER;
+}
+
+static double now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+int runProgram (const Image * image, const RunConfig * config,
+                FILE * statsFp)
+{
+    long           numWords = image->numWords;
+    Op           * ops = malloc((numWords + 2) * sizeof(Op));
+    size_t         memoryWords = config->memorySize / 4;
+    unsigned int * memory = calloc(memoryWords + 1, sizeof(unsigned int));
+    unsigned int   regs[NO_REGISTER + 1];
+    unsigned int   address = 0;
+    DataCache    * cache = config->dataCache;
+    long           pc = 0;      /* index of the next instruction */
+    long           from = 0;    /* index of the last branch or jump */
+    long           steps = 0, maxSteps;
+    int            stop, i;
+    double         start, seconds;
+
+    if ( ops == NULL || memory == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(ops);
+        free(memory);
+        return 0;
+    }
+
+    /* Decode every word once. */
+    for ( i = 0; i < numWords; i++ )
+        decodeOp(&ops[i], image->words[i], i, numWords);
+    ops[numWords].kind = OP_END;
+    ops[numWords + 1].kind = OP_OUTSIDE;
+
+    memset(regs, 0, sizeof(regs));
+    regs[29] = (unsigned int) (memoryWords * 4);
+    regs[31] = (unsigned int) (numWords * 4);
+    for ( i = 1; i < 32; i++ )
+        if ( config->registersGiven & (1U << i) )
+            regs[i] = config->registers[i];
+    maxSteps = config->maxSteps > 0 ? config->maxSteps : -1;
+
+    start = now();
+    stop = STOP_STEPS;
+    for ( ; steps != maxSteps; steps++ )
+    {
+        const Op * op = &ops[pc];
+
+        switch ( op->kind )
+        {
+            case OP_ADD:
+                regs[op->rd] = regs[op->rs] + regs[op->rt];
+                pc++;
+                continue;
+            case OP_SUB:
+                regs[op->rd] = regs[op->rs] - regs[op->rt];
+                pc++;
+                continue;
+            case OP_AND:
+                regs[op->rd] = regs[op->rs] & regs[op->rt];
+                pc++;
+                continue;
+            case OP_OR:
+                regs[op->rd] = regs[op->rs] | regs[op->rt];
+                pc++;
+                continue;
+            case OP_NOR:
+                regs[op->rd] = ~(regs[op->rs] | regs[op->rt]);
+                pc++;
+                continue;
+            case OP_SLT:
+                regs[op->rd] = (int) regs[op->rs] < (int) regs[op->rt];
+                pc++;
+                continue;
+            case OP_SLL:
+                regs[op->rd] = regs[op->rt] << op->imm;
+                pc++;
+                continue;
+            case OP_SRL:
+                regs[op->rd] = regs[op->rt] >> op->imm;
+                pc++;
+                continue;
+            case OP_ADDI:
+                regs[op->rd] = regs[op->rs] + (unsigned int) op->imm;
+                pc++;
+                continue;
+            case OP_ANDI:
+                regs[op->rd] = regs[op->rs] & (unsigned int) op->imm;
+                pc++;
+                continue;
+            case OP_ORI:
+                regs[op->rd] = regs[op->rs] | (unsigned int) op->imm;
+                pc++;
+                continue;
+            case OP_LUI:
+                regs[op->rd] = (unsigned int) op->imm << 16;
+                pc++;
+                continue;
+            case OP_LW:
+                address = regs[op->rs] + (unsigned int) op->imm;
+                if ( (address & 3) != 0 || address / 4 >= memoryWords )
+                    break;
+                if ( cache != NULL )
+                    dataCacheAccess(cache, address, 0, pc);
+                regs[op->rd] = memory[address / 4];
+                pc++;
+                continue;
+            case OP_SW:
+                address = regs[op->rs] + (unsigned int) op->imm;
+                if ( (address & 3) != 0 || address / 4 >= memoryWords )
+                    break;
+                if ( cache != NULL )
+                    dataCacheAccess(cache, address, 1, pc);
+                memory[address / 4] = regs[op->rt];
+                pc++;
+                continue;
+            case OP_BEQ:
+                from = pc;
+                pc = regs[op->rs] == regs[op->rt] ? op->imm : pc + 1;
+                continue;
+            case OP_BNE:
+                from = pc;
+                pc = regs[op->rs] != regs[op->rt] ? op->imm : pc + 1;
+                continue;
+            case OP_JAL:
+                regs[31] = (unsigned int) ((pc + 1) * 4);
+                /* fall through */
+            case OP_J:
+                from = pc;
+                pc = op->imm;
+                continue;
+            case OP_JR:
+                from = pc;
+                address = regs[op->rs];
+                pc = (address & 3) == 0 && address / 4 <= numWords ?
+                     (long) (address / 4) : numWords + 1;
+                continue;
+        }
+
+        /* Only an instruction that cannot go on gets here. */
+        stop = op->kind == OP_END ? STOP_END :
+               op->kind == OP_OUTSIDE ? STOP_OUTSIDE :
+               op->kind == OP_UNSUPPORTED ? STOP_UNSUPPORTED : STOP_MEMORY;
+        break;
+    }
+    seconds = now() - start;
+    if ( stop == STOP_STEPS && ops[pc].kind == OP_END )
+        stop = STOP_END;     /* the last step reached the end */
+
+    if ( stop == STOP_UNSUPPORTED )
+        printError("Error: line %d: the instruction at address %ld is not "
+                   "supported by --run.\n", image->lineNums[pc], pc * 4);
+    else if ( stop == STOP_OUTSIDE )
+        printError("Error: line %d: the instruction at address %ld jumps "
+                   "outside the program.\n", image->lineNums[from],
+                   from * 4);
+    else if ( stop == STOP_MEMORY )
+        printError("Error: line %d: the instruction at address %ld uses "
+                   "address %u, which is not a word in memory.\n",
+                   image->lineNums[pc], pc * 4, address);
+
+    for ( i = 1; i < 32; i++ )
+        if ( regs[i] != 0 )
+            printf("%-5s = %d\n", REGISTER_NAMES[i], (int) regs[i]);
+    if ( cache != NULL )
+    {
+        printf("\n");
+        dataCacheReport(cache, image, steps, stdout);
+    }
+
+    if ( statsFp != NULL )
+        fprintf(statsFp, "run: %ld instructions in %.3f s, %.1f million "
+                "instructions per second; %s\n", steps, seconds,
+                seconds > 0 ? steps / seconds / 1e6 : 0.0,
+                stop == STOP_END ? "reached the end" :
+                stop == STOP_STEPS ? "stopped at the step limit" :
+                "stopped on an error");
+
+    free(ops);
+    free(memory);
+    return stop == STOP_END || stop == STOP_STEPS;
+}
@@ -0,0 +1,89 @@
+/*
+ * Run: an interpreter that executes an assembled program (an image; see
+ * image.h).
+ *
+ * It supports add, sub, and, or, nor, slt, sll, srl, addi, andi, ori,
+ * lui, lw, sw, beq, bne, j, jal, and jr.  Before it runs, every word is
+ * decoded once into an Op, which holds what the instruction does and the
+ * numbers it needs (registers, immediate, or the index of a branch's
+ * target) in 8 bytes; running it is a loop around one switch.
+ *
+ * The machine has 32 registers and a separate data memory, addressed
+ * from 0, which lw and sw reach a word at a time.  Arithmetic wraps
+ * around rather than trapping on overflow.  The program starts at
+ * address 0, with $sp at the top of memory and $ra at the address just
+ * past the program (so that a final jr $ra ends the run), unless they
+ * are given other values.  It stops when it reaches that address, when
+ * it has run the given number of instructions, or when it goes wrong
+ * (an unsupported instruction, a jump outside the program, or a memory
+ * access outside memory or not on a word boundary).
+ *
+ * If a data cache is given (see dataCache.h), every lw and sw also goes
+ * through it, and how it did is reported at the end of the run.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _RUN_H
+#define _RUN_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "image.h"
+#include "dataCache.h"
+
+/* THE DATA STRUCTURES */
+
+#define RUN_DEFAULT_MEMORY (1024 * 1024)        /* bytes */
+
+/* What a decoded instruction does. */
+enum { OP_ADD, OP_SUB, OP_AND, OP_OR, OP_NOR, OP_SLT, OP_SLL, OP_SRL,
+       OP_ADDI, OP_ANDI, OP_ORI, OP_LUI, OP_LW, OP_SW, OP_BEQ, OP_BNE,
+       OP_J, OP_JAL, OP_JR,
+       OP_UNSUPPORTED,          /* any other word */
+       OP_END,                  /* the address just past the program */
+       OP_OUTSIDE };            /* a jump target outside the program */
+
+typedef struct {
+        unsigned char kind;     /* OP_ADD, ... */
+        unsigned char rd;       /* register written (32 for none, or for
+                                   $zero, which must stay 0) */
+        unsigned char rs, rt;   /* registers read */
+        int           imm;      /* immediate (sign- or zero-extended),
+                                   shift amount, or index of the target
+                                   instruction */
+} Op;
+
+typedef struct {
+        size_t       memorySize;        /* bytes of data memory */
+        long         maxSteps;          /* instructions to run at most
+                                           (0 for no limit) */
+        unsigned int registers[32];     /* starting values */
+        unsigned int registersGiven;    /* bit r is set if registers[r]
+                                           was given */
+        DataCache  * dataCache;         /* cache to model (NULL for none) */
+} RunConfig;
+
+
+/* THE FUNCTIONS */
+
+void runConfigInit (RunConfig * config);
+        /* Postcondition: config has the default memory size, no step
+         *      limit, no register values given, and no data cache.
+         */
+
+int runProgram (const Image * image, const RunConfig * config,
+                FILE * statsFp);
+        /* Postcondition: the program in image has been run, the values
+         *      of the registers that are not 0 at the end printed to
+         *      stdout, and the number of instructions run and the
+         *      instructions per second printed to statsFp.  If there is a
+         *      data cache, its report has been printed to stdout.
+         * Returns 1 if the program ran to its end or to the step limit;
+         *      0 if it went wrong (an error message has been printed).
+         */
+
+#endif
@@ -0,0 +1,266 @@
+/**
+ * long scheduleBlocks (Code * code, int insertNops, FILE * statsFp)
+ *      @param  code  the program, taken apart (see transform.h)
+ *      @param  insertNops  1 to put a nop between a load and an
+ *                          instruction right after it that uses what it
+ *                          loaded, for pipelines without interlocks
+ *      @param  statsFp  where to report what was done (NULL for nowhere)
+ *      @return the number of instructions moved, or -1 if memory could
+ *              not be allocated
+ *
+ * This function reorders the instructions in each basic block so that a
+ * loaded value is not used by the instruction right after the load,
+ * which would stall the pipeline for a cycle (see modelPipeline).
+ *
+ * Blocks end at pinned instructions (see transform.h), after branches
+ * and jumps, and after syscalls and unsupported words, which nothing
+ * moves across.  A block's pinned first instruction stays first, and the
+ * branch, jump, or syscall that ends it stays last; the instructions
+ * between are list scheduled, up to WINDOW at a time.  An instruction
+ * may move ahead of another unless one writes a register the other reads
+ * or writes, or both touch memory and one of them is a store, so loads
+ * and stores stay in order with each other.
+ *
+ * Without interlocks (insertNops), a store also needs a value it stores
+ * a cycle after it is loaded; otherwise it gets it by forwarding.
+ *
+ * At each step the scheduler takes, among the instructions whose
+ * predecessors have all been placed, one whose operands are ready
+ * (a loaded value is ready two cycles after the load, any other one
+ * cycle after it), preferring the one on the longest path to the end of
+ * the window, then the one that came first.  If none is ready, it takes
+ * the one that will be ready soonest, and the pipeline stalls.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "transform.h"
+#include "instrInfo.h"
+
+#define WINDOW  64              /* instructions scheduled at a time */
+#define NUM_REGS  34            /* 32 registers, HI, and LO */
+
+#define NOP  0x00000000U        /* sll $zero, $zero, 0 */
+
+/* Returns 1 if the instruction described by later must stay after the
+ * one described by earlier; 0 if they may be swapped.
+ */
+static int dependent(const InstrInfo * earlier, const InstrInfo * later)
+{
+    int memory = INFO_LOAD | INFO_STORE;
+
+    if ( (earlier->writes & (later->reads | later->writes)) ||
+         (earlier->reads & later->writes) )
+        return 1;
+    return (earlier->flags & memory) && (later->flags & memory) &&
+           ((earlier->flags | later->flags) & INFO_STORE);
+}
+
+/* Returns the registers the instruction in word, described by info,
+ * needs in EX.  A store needs the value it stores only in MEM, where a
+ * loaded value is forwarded to it, unless strict is 1 (no interlocks, so
+ * no forwarding from a load).
+ */
+static unsigned long long needsInEx(const InstrInfo * info, unsigned int word,
+                                    int strict)
+{
+    if ( strict || ! (info->flags & INFO_STORE) ||
+         ((word >> 21) & 0x1F) == ((word >> 16) & 0x1F) )
+        return info->reads;
+    return info->reads & ~REG_BIT((word >> 16) & 0x1F);
+}
+
+/* Returns 1 if the instruction in word, described by next, right after
+ * the one described by load, would use what it loads too soon.
+ */
+static int loadUse(const InstrInfo * load, const InstrInfo * next,
+                   unsigned int word, int strict)
+{
+    return (load->flags & INFO_LOAD) &&
+           (load->writes & needsInEx(next, word, strict));
+}
+
+/* Counts the loads used too soon in n instructions in a row. */
+static long countLoadUse(const CodeInstr * instrs, long n, int strict)
+{
+    InstrInfo previous, info;
+    long      stalls = 0, i;
+
+    for ( i = 0; i < n; i++ )
+    {
+        instrInfo(instrs[i].word, 0, &info);
+        if ( i > 0 && loadUse(&previous, &info, instrs[i].word, strict) )
+            stalls++;
+        previous = info;
+    }
+    return stalls;
+}
+
+/* Places instrs[0 .. n), at most WINDOW of them, at out[0 .. n), in the
+ * order chosen by list scheduling.  The last one stays last if fixLast is
+ * 1; strict is as for needsInEx.  ready[r] is the cycle at which register
+ * r's value is ready, and *cycle the cycle of the next instruction; both
+ * are brought up to date.
+ */
+static void scheduleWindow(const CodeInstr * instrs, const InstrInfo * infos,
+                           int n, int fixLast, int strict, CodeInstr * out,
+                           long ready[NUM_REGS], long * cycle)
+{
+    unsigned long long preds[WINDOW], placed = 0;
+    int                height[WINDOW];
+    int                i, k, r, step;
+
+    for ( k = 0; k < n; k++ )
+    {
+        preds[k] = 0;
+        for ( i = 0; i < k; i++ )
+            if ( dependent(&infos[i], &infos[k]) ||
+                 (fixLast && k == n - 1) )
+                preds[k] |= 1ULL << i;
+    }
+
+    /* The length of the longest path from each instruction to the end. */
+    for ( i = n - 1; i >= 0; i-- )
+    {
+        height[i] = 1;
+        for ( k = i + 1; k < n; k++ )
+            if ( preds[k] & (1ULL << i) )
+            {
+                int length = height[k] +
+                             (loadUse(&infos[i], &infos[k], instrs[k].word,
+                                      strict) ? 2 : 1);
+
+                if ( length > height[i] )
+                    height[i] = length;
+            }
+    }
+
+    for ( step = 0; step < n; step++ )
+    {
+        int  best = -1;
+        long bestReady = 0;
+
+        for ( k = 0; k < n; k++ )
+        {
+            unsigned long long inEx;
+            long               when = *cycle;
+
+            if ( (placed & (1ULL << k)) || (preds[k] & ~placed) )
+                continue;
+            inEx = needsInEx(&infos[k], instrs[k].word, strict);
+            for ( r = 1; r < NUM_REGS; r++ )
+                if ( (inEx & REG_BIT(r)) && ready[r] > when )
+                    when = ready[r];
+            if ( best == -1 || when < bestReady ||
+                 (when == bestReady && height[k] > height[best]) )
+            {
+                best = k;
+                bestReady = when;
+            }
+        }
+
+        placed |= 1ULL << best;
+        out[step] = instrs[best];
+        *cycle = bestReady;
+        for ( r = 1; r < NUM_REGS; r++ )
+            if ( infos[best].writes & REG_BIT(r) )
+                ready[r] = *cycle + (infos[best].flags & INFO_LOAD ? 2 : 1);
+        (*cycle)++;
+    }
+}
+
+long scheduleBlocks (Code * code, int insertNops, FILE * statsFp)
+{
+    long        n = code->numInstrs, i, numNew, moved = 0, blocks = 0;
+    long        before, after, nops = 0;
+    CodeInstr * instrs = code->instrs;
+    CodeInstr * out = malloc((2 * n + 1) * sizeof(CodeInstr));
+    InstrInfo * infos = malloc((n + 1) * sizeof(InstrInfo));
+    long        ready[NUM_REGS], cycle = 0;
+    int         ends = INFO_BRANCH | INFO_JUMP | INFO_BARRIER;
+
+    if ( out == NULL || infos == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        free(out);
+        free(infos);
+        return -1;
+    }
+    for ( i = 0; i < n; i++ )
+        instrInfo(instrs[i].word, 0, &infos[i]);
+    for ( i = 0; i < NUM_REGS; i++ )
+        ready[i] = 0;
+    before = countLoadUse(instrs, n, insertNops);
+
+    for ( i = 0; i < n; )
+    {
+        long start = i, end = i + 1, from;
+
+        /* Find the end of the block. */
+        while ( end < n && ! instrs[end].pinned &&
+                ! (infos[end - 1].flags & ends) )
+            end++;
+        blocks++;
+
+        /* A pinned first instruction stays first. */
+        from = start;
+        if ( instrs[start].pinned || (infos[start].flags & ends) )
+        {
+            scheduleWindow(&instrs[from], &infos[from], 1, 0, insertNops,
+                           &out[from], ready, &cycle);
+            from++;
+        }
+        while ( from < end )
+        {
+            int size = end - from > WINDOW ? WINDOW : (int) (end - from);
+
+            scheduleWindow(&instrs[from], &infos[from], size,
+                           from + size == end &&
+                           (infos[end - 1].flags & ends) != 0, insertNops,
+                           &out[from], ready, &cycle);
+            from += size;
+        }
+        i = end;
+    }
+    for ( i = 0; i < n; i++ )
+        moved += out[i].origin != instrs[i].origin;
+    after = countLoadUse(out, n, insertNops);
+
+    /* Separate each load from a use right after it. */
+    numNew = n;
+    if ( insertNops && after > 0 )
+    {
+        InstrInfo previous, info;
+        long      j;
+
+        for ( i = n - 1, j = n + after; i >= 0; i-- )
+        {
+            out[--j] = out[i];
+            if ( i > 0 )
+            {
+                instrInfo(out[j].word, 0, &info);
+                instrInfo(out[i - 1].word, 0, &previous);
+                if ( loadUse(&previous, &info, out[j].word, 1) )
+                {
+                    out[--j].word = NOP;
+                    out[j].lineNum = out[i - 1].lineNum;
+                    out[j].origin = -1;
+                    out[j].target = -1;
+                    out[j].pinned = 0;
+                    nops++;
+                }
+            }
+        }
+        numNew = n + nops;
+    }
+    codeReplace(code, out, numNew);
+
+    if ( statsFp != NULL )
+        fprintf(statsFp, "schedule: %ld blocks, %ld instructions moved; "
+                "load-use stalls %ld before, %ld after; %ld nops "
+                "inserted\n", blocks, moved, before, after, nops);
+
+    free(infos);
+    return moved;
+}
@@ -0,0 +1,78 @@
+/*
+ * SPSC ring: functions to push items into and pop items out of a
+ * single-producer/single-consumer ring.  See spscRing.h for details.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <stdlib.h>
+#include <sched.h>
+
+#include "spscRing.h"
+#include "printFuncs.h"
+
+int spscInit (SpscRing * ring, unsigned int capacity)
+{
+    if ( (ring->items = malloc(capacity * sizeof(void *))) == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        return 0;
+    }
+    ring->mask = capacity - 1;
+    atomic_init(&ring->head, 0);
+    atomic_init(&ring->tail, 0);
+    return 1;
+}
+
+void spscFree (SpscRing * ring)
+{
+    free(ring->items);
+    ring->items = NULL;
+}
+
+int spscTryPush (SpscRing * ring, void * item)
+{
+    unsigned int tail = atomic_load_explicit(&ring->tail,
+                                             memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&ring->head,
+                                             memory_order_acquire);
+
+    /* The indexes wrap around; the difference is the number of items. */
+    if ( tail - head > ring->mask )
+        return 0;
+
+    ring->items[tail & ring->mask] = item;
+    atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+    return 1;
+}
+
+void * spscTryPop (SpscRing * ring)
+{
+    unsigned int head = atomic_load_explicit(&ring->head,
+                                             memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&ring->tail,
+                                             memory_order_acquire);
+    void * item;
+
+    if ( head == tail )
+        return NULL;
+
+    item = ring->items[head & ring->mask];
+    atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+    return item;
+}
+
+void spscPush (SpscRing * ring, void * item)
+{
+    while ( ! spscTryPush(ring, item) )
+        sched_yield();
+}
+
+void * spscPop (SpscRing * ring)
+{
+    void * item;
+
+    while ( (item = spscTryPop(ring)) == NULL )
+        sched_yield();
+    return item;
+}
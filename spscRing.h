@@ -0,0 +1,66 @@
+/*
+ * SPSC ring: a bounded, lock-free, single-producer/single-consumer queue.
+ *
+ * A ring connects two threads: exactly one thread pushes items into it
+ * and exactly one (other) thread pops items out of it, in the order in
+ * which they were pushed.  No locks are used; the producer only writes
+ * the tail index and the consumer only writes the head index, and each
+ * reads the other's index with acquire/release ordering so that an item
+ * is fully written before the consumer can see it.
+ *
+ * The items are pointers (typically to batches of work).  A ring holds
+ * at most its capacity, which must be a power of two.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _SPSC_RING_H
+#define _SPSC_RING_H
+
+#include <stdatomic.h>
+
+/* THE DATA STRUCTURE */
+
+/* The head and tail are kept on separate cache lines so that the two
+ * threads do not slow each other down by writing to the same line.
+ */
+typedef struct {
+        void ** items;          /* capacity slots for items */
+        unsigned int mask;      /* capacity - 1 */
+        _Alignas(64) atomic_uint head;  /* next slot to pop (consumer) */
+        _Alignas(64) atomic_uint tail;  /* next slot to push (producer) */
+} SpscRing;
+
+
+/* THE FUNCTIONS */
+
+int spscInit (SpscRing * ring, unsigned int capacity);
+        /* Precondition: capacity is a power of two.
+         * Postcondition: ring is empty and can hold capacity items.
+         * Returns 1 if everything went OK; 0 if memory allocation error.
+         */
+
+void spscFree (SpscRing * ring);
+        /* Postcondition: the ring's memory has been released. */
+
+int spscTryPush (SpscRing * ring, void * item);
+        /* Producer only.  Returns 1 if item was added to the ring; 0 if
+         *      the ring was full.
+         */
+
+void * spscTryPop (SpscRing * ring);
+        /* Consumer only.  Returns the oldest item in the ring, removing
+         *      it; NULL if the ring was empty.
+         */
+
+void spscPush (SpscRing * ring, void * item);
+        /* Producer only.  Adds item to the ring, waiting (yielding the
+         *      processor) while the ring is full.
+         */
+
+void * spscPop (SpscRing * ring);
+        /* Consumer only.  Removes and returns the oldest item in the
+         *      ring, waiting (yielding the processor) while it is empty.
+         */
+
+#endif
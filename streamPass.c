@@ -0,0 +1,337 @@
+/**
+ * void streamPass (FILE * fp, LabelTableArrayList * table, FILE * statsFp)
+ *      @param  fp  pointer to an open file (stdin or other file pointer)
+ *                  from which to read lines of assembly source code
+ *      @param  table  a pointer to an existing, empty Label Table, which
+ *                  is filled in as labels are found
+ *      @param  statsFp  file to which to print statistics about the
+ *                  references that had to wait for their labels, or NULL
+ *
+ * This function does the work of pass1 and pass2 in a single pass over
+ * the input, so that output starts as soon as lines arrive and the
+ * input never has to be rewound (it may be a pipe).
+ *
+ * Each line's label, if any, is added to the table before the line is
+ * encoded, so references to labels that have already been seen
+ * (backward references) are resolved at once.  An instruction that
+ * refers to a label that has not been seen yet (a forward reference) is
+ * encoded with that field left as 0 and put on a waiter list for the
+ * label; when the label is defined, every instruction on its list is
+ * patched.  The waiter lists are kept in a second label table that maps
+ * each awaited label to the head of its list.
+ *
+ * Output must stay in order, so encoded words are held in a window until
+ * every word before them is complete; the longest prefix of the window
+ * with no unresolved references is written as soon as it exists.  Memory
+ * is therefore proportional to the distance spanned by forward
+ * references, rather than to the length of the input.
+ *
+ * The output is identical to that of pass1 followed by pass2.  References
+ * to labels that are still undefined at the end of the input are
+ * reported, in line order, and those instructions produce no output.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "encodeCache.h"
+
+#define WORD_READY    -1        /* window entry is complete */
+#define WORD_DROPPED  -2        /* window entry is not written (error) */
+
+/* An instruction waiting for a label to be defined. */
+typedef struct {
+        LabelRef ref;           /* the reference (ref.label is not used) */
+        int      label;         /* entry number of the label in the table
+                                   of awaited labels */
+        long     seq;           /* number of the instruction's word */
+        int      next;          /* next waiter for the same label (or the
+                                   next free waiter); -1 if none */
+} Waiter;
+
+/* Words that have been encoded but not yet written, oldest first. */
+typedef struct {
+        unsigned int * words;
+        int    * waiter;        /* waiter for each word, or WORD_READY or
+                                   WORD_DROPPED */
+        int      start, end;    /* words[start..end) are held */
+        int      capacity;
+        long     baseSeq;       /* number of the word in words[0] */
+} Window;
+
+/* Everything streamPass keeps track of. */
+typedef struct {
+        LabelTableArrayList * table;    /* labels defined so far */
+        LabelTableArrayList awaited;    /* label -> first waiter (or -1) */
+        Waiter * waiters;
+        int      numWaiters, maxWaiters;
+        int      freeWaiter;            /* first unused waiter, or -1 */
+        int      pending, peakPending;  /* references not yet resolved */
+        long     numForward;            /* forward references seen */
+        int      peakHeld;              /* most words held at once */
+        Window   window;
+} Stream;
+
+static int  holdWord(Stream * stream, unsigned int word, int waiter);
+static int  addWaiter(Stream * stream, const LabelRef * ref, long seq);
+static void resolveLabel(Stream * stream, char * label, int address);
+static void writeReady(Window * window);
+static void dropUnresolved(Stream * stream);
+
+void streamPass (FILE * fp, LabelTableArrayList * table, FILE * statsFp)
+{
+    Stream   stream;
+    int      lineNum;
+    int      address = 0;      /* address of the instruction on this line */
+    char     inst[BUFSIZ];     /* will hold instruction */
+    char     copy[BUFSIZ];     /* copy of it for finding the label */
+    char   * label;
+    unsigned int word;
+    LabelRef ref;
+    InstrFields fields;
+    EncodeCache cache;         /* instructions already encoded */
+    int      result;
+    long     seq = 0;          /* number of words encoded so far */
+
+    if ( table->capacity < 10 && tableResize(table, 10) == 0 )
+        return;         /* error message already printed */
+
+    memset(&stream, 0, sizeof(stream));
+    stream.table = table;
+    stream.freeWaiter = -1;
+    tableInit(&stream.awaited);
+    cacheInit(&cache);
+
+    for ( lineNum = 1; fgets(inst, BUFSIZ, fp); lineNum++ )
+    {
+        /* Define the line's label first (as pass1 would have), so that
+         * an instruction may refer to its own label, and complete the
+         * instructions that were waiting for it.
+         */
+        strcpy(copy, inst);
+        if ( (label = getLabel(copy)) != NULL )
+        {
+            addLabel(table, label, address);
+            resolveLabel(&stream, label, address);
+        }
+
+        /* Encode the instruction, putting it on a waiter list if it
+         * refers to a label that has not been defined yet.  (Cached
+         * instructions never refer to labels.)
+         */
+        result = cacheDecode(&cache, inst, lineNum, address + 4, table,
+                             &fields, &word, &ref);
+        address += addressStep(result);
+        if ( result == ASM_OK )
+            word = packFields(&fields);
+        else if ( result != ASM_CACHED )
+            continue;
+        if ( ref.kind == REF_NONE )
+        {
+            if ( ! holdWord(&stream, word, WORD_READY) )
+                break;
+        }
+        else if ( ! holdWord(&stream, word, addWaiter(&stream, &ref, seq)) )
+            break;
+        seq++;
+
+        writeReady(&stream.window);
+    }
+
+    /* Whatever is still waiting refers to labels that were never
+     * defined.
+     */
+    dropUnresolved(&stream);
+    writeReady(&stream.window);
+
+    if ( statsFp != NULL )
+        fprintf(statsFp, "stream: %ld forward references, at most %d "
+                "pending; at most %d words held for output\n",
+                stream.numForward, stream.peakPending, stream.peakHeld);
+
+    cacheFree(&cache);
+    tableFree(&stream.awaited);
+    free(stream.waiters);
+    free(stream.window.words);
+    free(stream.window.waiter);
+}
+
+/* Adds a word to the end of the output window.  Returns 1 if it was
+ * added; 0 if memory allocation error (an error message was printed).
+ *    @param waiter  the word's waiter, or WORD_READY if it is complete
+ */
+static int holdWord(Stream * stream, unsigned int word, int waiter)
+{
+    Window * window = &stream->window;
+
+    if ( waiter == WORD_DROPPED )
+        return 0;       /* addWaiter failed */
+
+    if ( window->end == window->capacity )
+    {
+        /* Move the held words to the front; grow if still mostly full. */
+        int held = window->end - window->start;
+
+        memmove(window->words, window->words + window->start,
+                held * sizeof(unsigned int));
+        memmove(window->waiter, window->waiter + window->start,
+                held * sizeof(int));
+        window->baseSeq += window->start;
+        window->start = 0;
+        window->end = held;
+
+        if ( held >= window->capacity / 2 )
+        {
+            int newCapacity = window->capacity > 0 ? 2 * window->capacity
+                                                   : 1024;
+            unsigned int * words = realloc(window->words,
+                                          newCapacity * sizeof(unsigned int));
+            int * waiters = words == NULL ? NULL :
+                    realloc(window->waiter, newCapacity * sizeof(int));
+
+            if ( words != NULL )
+                window->words = words;
+            if ( waiters == NULL )
+            {
+                printError("Error: cannot allocate space in memory.\n");
+                return 0;
+            }
+            window->waiter = waiters;
+            window->capacity = newCapacity;
+        }
+    }
+
+    window->words[window->end] = word;
+    window->waiter[window->end] = waiter;
+    window->end++;
+    if ( window->end - window->start > stream->peakHeld )
+        stream->peakHeld = window->end - window->start;
+    return 1;
+}
+
+/* Puts word number seq, whose reference is described by ref, on the
+ * waiter list for its label.  Returns the waiter's index, or
+ * WORD_DROPPED if memory allocation error.
+ */
+static int addWaiter(Stream * stream, const LabelRef * ref, long seq)
+{
+    Waiter * waiter;
+    int      index, label;
+
+    /* Reuse a waiter whose label has been defined, if there is one. */
+    if ( (index = stream->freeWaiter) != -1 )
+        stream->freeWaiter = stream->waiters[index].next;
+    else
+    {
+        if ( stream->numWaiters == stream->maxWaiters )
+        {
+            int newMax = stream->maxWaiters > 0 ? 2 * stream->maxWaiters
+                                                : 64;
+            Waiter * waiters = realloc(stream->waiters,
+                                       newMax * sizeof(Waiter));
+            if ( waiters == NULL )
+            {
+                printError("Error: cannot allocate space in memory.\n");
+                return WORD_DROPPED;
+            }
+            stream->waiters = waiters;
+            stream->maxWaiters = newMax;
+        }
+        index = stream->numWaiters++;
+    }
+
+    /* Find (or start) the list of waiters for this label. */
+    if ( (label = findLabelIndex(&stream->awaited, ref->label)) == -1 )
+    {
+        if ( ! addLabel(&stream->awaited, ref->label, -1) )
+            return WORD_DROPPED;
+        label = findLabelIndex(&stream->awaited, ref->label);
+    }
+
+    waiter = &stream->waiters[index];
+    waiter->ref = *ref;
+    waiter->ref.label = NULL;   /* the line it pointed into is reused */
+    waiter->label = label;
+    waiter->seq = seq;
+    waiter->next = stream->awaited.addresses[label];
+    stream->awaited.addresses[label] = index;
+
+    stream->numForward++;
+    if ( ++stream->pending > stream->peakPending )
+        stream->peakPending = stream->pending;
+    return index;
+}
+
+/* Patches every word waiting for label, which has just been defined at
+ * address, and frees its waiters.  A branch that cannot reach the label
+ * is reported and not written.
+ */
+static void resolveLabel(Stream * stream, char * label, int address)
+{
+    Window * window = &stream->window;
+    int      entry, index, next;
+
+    if ( (entry = findLabelIndex(&stream->awaited, label)) == -1 )
+        return;
+
+    for ( index = stream->awaited.addresses[entry]; index != -1;
+          index = next )
+    {
+        Waiter * waiter = &stream->waiters[index];
+        int      slot = (int) (waiter->seq - window->baseSeq);
+
+        if ( patchLabelRef(&window->words[slot], &waiter->ref, address) )
+            window->waiter[slot] = WORD_READY;
+        else
+        {
+            printError("Line %d: branch target %s is too far away.\n",
+                       waiter->ref.lineNum, label);
+            window->waiter[slot] = WORD_DROPPED;
+        }
+
+        next = waiter->next;
+        waiter->next = stream->freeWaiter;
+        stream->freeWaiter = index;
+        stream->pending--;
+    }
+    stream->awaited.addresses[entry] = -1;
+}
+
+/* Writes the complete words at the front of the window. */
+static void writeReady(Window * window)
+{
+    char output[MAX_WORD_LENGTH];
+
+    while ( window->start < window->end &&
+            window->waiter[window->start] < 0 )
+    {
+        if ( window->waiter[window->start] == WORD_READY )
+        {
+            fwrite(output, 1, formatWord(window->words[window->start],
+                                         output), stdout);
+        }
+        window->start++;
+    }
+}
+
+/* Reports every word still waiting for a label, in order, and marks it
+ * so that it is not written.
+ */
+static void dropUnresolved(Stream * stream)
+{
+    Window * window = &stream->window;
+    int      slot;
+
+    for ( slot = window->start; slot < window->end; slot++ )
+    {
+        Waiter * waiter;
+
+        if ( window->waiter[slot] < 0 )
+            continue;
+        waiter = &stream->waiters[window->waiter[slot]];
+        printError("Line %d: label %s is not defined.\n",
+                   waiter->ref.lineNum,
+                   tableLabelName(&stream->awaited, waiter->label));
+        window->waiter[slot] = WORD_DROPPED;
+    }
+}
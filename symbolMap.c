@@ -0,0 +1,241 @@
+/*
+ * Symbol map: functions to save a label table to a file, as a symbol
+ * map or as text, and to map a saved symbol map into memory.
+ *
+ * See symbolMap.h for a description of a symbol map.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "symbolMap.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char * ERROR = "Error: cannot allocate space in memory.\n";
+
+/* A label's address and entry number, for sorting by address. */
+typedef struct {
+        int address;
+        int index;
+} Symbol;
+
+static int compareSymbols(const void * a, const void * b)
+{
+    const Symbol * first = a, * second = b;
+
+    if ( first->address != second->address )
+        return first->address < second->address ? -1 : 1;
+    return first->index - second->index;
+}
+
+/* Returns 1 if every slot of table's index is empty or holds one of its
+ * entries, with exactly one slot per entry (so that lookups, which probe
+ * until they find an empty slot, stop), and every name lies within the
+ * pool and ends in a null character; 0 if not.
+ */
+static int validArrays(const LabelTableArrayList * table)
+{
+    int i, used = 0;
+
+    for ( i = 0; i < table->numSlots; i++ )
+    {
+        if ( table->slots[i] < 0 || table->slots[i] > table->nbrLabels )
+            return 0;
+        used += table->slots[i] != 0;
+    }
+    if ( used != table->nbrLabels )
+        return 0;
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        size_t end = (size_t) table->offsets[i] + table->lengths[i];
+
+        if ( end >= table->poolSize || table->pool[end] != '\0' )
+            return 0;
+    }
+    return 1;
+}
+
+size_t symbolArraysSize (unsigned int nbrLabels, unsigned int numSlots,
+                         unsigned int poolSize)
+{
+    return (size_t) nbrLabels * 4 * sizeof(unsigned int) +
+           (size_t) numSlots * sizeof(int) + poolSize;
+}
+
+int symbolArraysWrite (LabelTableArrayList * table, FILE * fp)
+{
+    size_t n = (size_t) table->nbrLabels;
+
+    return fwrite(table->hashes, sizeof(unsigned int), n, fp) == n &&
+           fwrite(table->offsets, sizeof(unsigned int), n, fp) == n &&
+           fwrite(table->lengths, sizeof(unsigned int), n, fp) == n &&
+           fwrite(table->addresses, sizeof(int), n, fp) == n &&
+           fwrite(table->slots, sizeof(int), table->numSlots, fp) ==
+               (size_t) table->numSlots &&
+           fwrite(table->pool, 1, table->poolSize, fp) == table->poolSize;
+}
+
+int symbolArraysMap (LabelTableArrayList * table, const void * data,
+                     size_t size, unsigned int nbrLabels,
+                     unsigned int numSlots, unsigned int poolSize)
+{
+    size_t n = nbrLabels;
+
+    tableInit(table);
+
+    /* Every lookup probes the index until it finds an empty slot, so
+     * there must be one; and every name must end in a null character.
+     */
+    if ( (numSlots & (numSlots - 1)) != 0 ||
+         (nbrLabels > 0 && numSlots <= nbrLabels) ||
+         symbolArraysSize(nbrLabels, numSlots, poolSize) != size ||
+         (poolSize > 0 && ((const char *) data)[size - 1] != '\0') )
+        return 0;
+
+    /* Point the table's arrays into the data. */
+    table->capacity = table->nbrLabels = nbrLabels;
+    table->hashes = (unsigned int *) data;
+    table->offsets = table->hashes + n;
+    table->lengths = table->offsets + n;
+    table->addresses = (int *) (table->lengths + n);
+    table->slots = table->addresses + n;
+    table->numSlots = numSlots;
+    table->pool = (char *) (table->slots + numSlots);
+    table->poolSize = table->poolCapacity = poolSize;
+
+    /* Lookups trust the index and the names, so a damaged file must not
+     * get this far.
+     */
+    if ( ! validArrays(table) )
+    {
+        tableInit(table);
+        return 0;
+    }
+    return 1;
+}
+
+int symbolMapWrite (LabelTableArrayList * table, const char * name)
+{
+    SymbolMapHeader header;
+    FILE          * fp = fopen(name, "wb");
+    int             ok;
+
+    if ( fp == NULL )
+    {
+        printError("Error: cannot open symbol map %s.\n", name);
+        return 0;
+    }
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SYMBOL_MAP_MAGIC, sizeof(header.magic));
+    header.nbrLabels = table->nbrLabels;
+    header.numSlots = table->numSlots;
+    header.poolSize = table->poolSize;
+    header.version = SYMBOL_MAP_VERSION;
+
+    ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+         symbolArraysWrite(table, fp);
+    if ( fclose(fp) != 0 || ! ok )
+    {
+        printError("Error: cannot write symbol map %s.\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+int symbolMapWriteText (LabelTableArrayList * table, const char * name)
+{
+    Symbol * symbols = malloc((table->nbrLabels + 1) * sizeof(Symbol));
+    FILE   * fp;
+    int      i, ok = 1;
+
+    if ( symbols == NULL )
+    {
+        printError("%s", ERROR);
+        return 0;
+    }
+    if ( (fp = fopen(name, "w")) == NULL )
+    {
+        printError("Error: cannot open symbol list %s.\n", name);
+        free(symbols);
+        return 0;
+    }
+
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        symbols[i].address = table->addresses[i];
+        symbols[i].index = i;
+    }
+    qsort(symbols, table->nbrLabels, sizeof(Symbol), compareSymbols);
+    for ( i = 0; i < table->nbrLabels && ok; i++ )
+        ok = fprintf(fp, "%08x %s\n", (unsigned) symbols[i].address,
+                     tableLabelName(table, symbols[i].index)) > 0;
+
+    free(symbols);
+    if ( fclose(fp) != 0 || ! ok )
+    {
+        printError("Error: cannot write symbol list %s.\n", name);
+        return 0;
+    }
+    return 1;
+}
+
+/* Returns 1 if header starts a symbol map; 0 if not. */
+static int validHeader(const SymbolMapHeader * header, size_t size)
+{
+    return size >= sizeof(SymbolMapHeader) &&
+           memcmp(header->magic, SYMBOL_MAP_MAGIC, sizeof(header->magic))
+               == SAME &&
+           header->version == SYMBOL_MAP_VERSION;
+}
+
+int symbolMapOpen (SymbolMap * symbols, const char * name)
+{
+    struct stat       info;
+    SymbolMapHeader * header;
+    int               fd;
+
+    memset(symbols, 0, sizeof(SymbolMap));
+    tableInit(&symbols->table);
+
+    if ( (fd = open(name, O_RDONLY)) == -1 )
+    {
+        printError("Error: cannot open symbol map %s.\n", name);
+        return 0;
+    }
+    if ( fstat(fd, &info) == 0 && info.st_size > 0 )
+    {
+        symbols->map = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE,
+                            fd, 0);
+        if ( symbols->map == MAP_FAILED )
+            symbols->map = NULL;
+        else
+            symbols->mapSize = info.st_size;
+    }
+    close(fd);
+
+    header = symbols->map;
+    if ( header == NULL || ! validHeader(header, symbols->mapSize) ||
+         ! symbolArraysMap(&symbols->table, header + 1,
+                           symbols->mapSize - sizeof(SymbolMapHeader),
+                           header->nbrLabels, header->numSlots,
+                           header->poolSize) )
+    {
+        printError("Error: %s is not a valid symbol map.\n", name);
+        symbolMapClose(symbols);
+        return 0;
+    }
+    return 1;
+}
+
+void symbolMapClose (SymbolMap * symbols)
+{
+    if ( symbols->map != NULL )
+        munmap(symbols->map, symbols->mapSize);
+    memset(symbols, 0, sizeof(SymbolMap));
+    tableInit(&symbols->table);
+}
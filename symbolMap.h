@@ -0,0 +1,130 @@
+/*
+ * Symbol map: a label table saved to a file, to be mapped into memory
+ * and used by a later assembly.
+ *
+ * A symbol map lets a small program (a patch, say) refer to the labels
+ * of a large one that has already been assembled, without reading the
+ * large program's source again.  The file holds the table exactly as a
+ * LabelTableArrayList keeps it in memory -- the parallel arrays of
+ * hashes, name offsets, name lengths, and addresses, the hash index,
+ * and the string pool -- after a small header:
+ *
+ *      "MIPSSYM1"                      8 bytes
+ *      nbrLabels, numSlots, poolSize   3 unsigned ints
+ *      version                         1 unsigned int
+ *      hashes[nbrLabels]
+ *      offsets[nbrLabels]
+ *      lengths[nbrLabels]
+ *      addresses[nbrLabels]
+ *      slots[numSlots]
+ *      pool[poolSize]
+ *
+ * All numbers are in the byte order of the machine that wrote the map.
+ * Because the hashes and the index are saved with the labels (see
+ * labelHash), opening a map costs one mmap call: the table's arrays
+ * simply point into the mapped file.  Only the index and the name
+ * offsets are checked (one pass over each), so that a damaged file is
+ * rejected rather than read out of bounds.
+ *
+ * A symbol map may also be written as text, one label per line, in
+ * order of address, for debuggers and people:
+ *
+ *      00000040 loop
+ *
+ * The same arrays, without the header, make up the symbol sections of
+ * an object file (see objectFile.h); symbolArraysWrite and
+ * symbolArraysMap save and map them.
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _SYMBOL_MAP_H
+#define _SYMBOL_MAP_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+#include "LabelTableArrayList.h"
+
+/* THE DATA STRUCTURES */
+
+#define SYMBOL_MAP_MAGIC   "MIPSSYM1"
+#define SYMBOL_MAP_VERSION 1
+
+typedef struct {
+        char         magic[8];  /* SYMBOL_MAP_MAGIC (not null-terminated) */
+        unsigned int nbrLabels;
+        unsigned int numSlots;  /* slots in the hash index */
+        unsigned int poolSize;  /* bytes of label names */
+        unsigned int version;   /* SYMBOL_MAP_VERSION */
+} SymbolMapHeader;
+
+typedef struct {
+        LabelTableArrayList table;      /* the labels (read only) */
+        void   * map;           /* the mapped file, or NULL */
+        size_t   mapSize;       /* bytes mapped */
+} SymbolMap;
+
+
+/* THE FUNCTIONS */
+
+size_t symbolArraysSize (unsigned int nbrLabels, unsigned int numSlots,
+                         unsigned int poolSize);
+        /* Returns the number of bytes taken by the arrays of a table with
+         *      nbrLabels labels, numSlots slots in its index, and
+         *      poolSize bytes of names.
+         */
+
+int symbolArraysWrite (LabelTableArrayList * table, FILE * fp);
+        /* Postcondition: the arrays of table (hashes, offsets, lengths,
+         *      addresses, slots, and pool, in that order) have been
+         *      written to fp.
+         * Returns 1 if everything went OK; 0 if a write failed.
+         */
+
+int symbolArraysMap (LabelTableArrayList * table, const void * data,
+                     size_t size, unsigned int nbrLabels,
+                     unsigned int numSlots, unsigned int poolSize);
+        /* Precondition: data is aligned for unsigned ints, and holds
+         *      size bytes written by symbolArraysWrite.
+         * Postcondition: table's arrays point into data; the table must
+         *      not be changed, and is only valid as long as data is.
+         * Returns 1 if everything went OK; 0 if the counts do not
+         *      describe size bytes of searchable arrays, or an index slot
+         *      or a name lies outside them (table is then empty).
+         */
+
+int symbolMapWrite (LabelTableArrayList * table, const char * name);
+        /* Postcondition: the labels in table (not its imported labels)
+         *      have been saved in the symbol map file name.
+         * Returns 1 if everything went OK; 0 if an error occurred (an
+         *      error message has been printed).
+         */
+
+int symbolMapWriteText (LabelTableArrayList * table, const char * name);
+        /* Postcondition: the labels in table (not its imported labels)
+         *      have been written to the text file name, in order of
+         *      address (labels at the same address in the order they
+         *      were defined).
+         * Returns 1 if everything went OK; 0 if an error occurred (an
+         *      error message has been printed).
+         */
+
+int symbolMapOpen (SymbolMap * symbols, const char * name);
+        /* Postcondition: symbols->table holds the labels saved in the
+         *      symbol map file name, mapped into memory.  The table must
+         *      not be changed; it can be used as another table's
+         *      imported labels.
+         * Returns 1 if everything went OK; 0 if the file cannot be
+         *      opened or is not a valid symbol map (an error message has
+         *      been printed, and symbols->table is empty).
+         */
+
+void symbolMapClose (SymbolMap * symbols);
+        /* Postcondition: the symbol map has been unmapped; its table is
+         *      empty.
+         */
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * This is a test driver for the disassembler.  In every output format,
+ * it runs ./assembler on smallSampleTestfile.mips, disassembles the
+ * words with --disassemble, and assembles the source that prints again.
+ * The words must come back identical (and, in the default format, match
+ * smallSampleTestfile.mips.out).  It does the same, with labels from an
+ * --emit-symbols map, for a loop with a word that is not an instruction
+ * (printed as a .word directive) between its branches.  It prints each
+ * result and exits with status 1 if any words differ.
+ *
+ * The assembler must already have been built in the current directory.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "assembler.h"
+
+#define SAMPLE      "smallSampleTestfile.mips"
+#define SAMPLE_OUT  "smallSampleTestfile.mips.out"
+#define WORDS       "testDisassemble.words"
+#define SOURCE      "testDisassemble.mips"
+#define REASSEMBLED "testDisassemble.reassembled"
+#define WORD_SOURCE "testDisassembleWord.mips"
+#define WORD_HEX    "testDisassembleWord.hex"
+#define SYMBOLS     "testDisassemble.sym"
+
+/* A loop with a word that no instruction encodes, and its words. */
+static const char * wordSource =
+    "main:   addi $t0, $zero, 3\n"
+    "loop:   beq $t0, $zero, done\n"
+    "        .word 0xffffffff            # not an instruction\n"
+    "        addi $t0, $t0, -1\n"
+    "        j loop\n"
+    "done:   bne $t0, $zero, main\n"
+    "        jr $ra\n";
+
+static const char * wordHex =
+    "20080003\n11000003\nffffffff\n2108ffff\n08000001\n1500fffa\n"
+    "03e00008\n";
+
+static const char * formats[] = { "binary", "hex", "raw" };
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* Writes text to path.  Returns 1 if it could be written. */
+static int writeFile(const char * path, const char * text)
+{
+    FILE * fp = fopen(path, "w");
+
+    if ( fp == NULL )
+        return 0;
+    fputs(text, fp);
+    return fclose(fp) == 0;
+}
+
+/* Runs ./assembler with the given arguments and its stdout sent to
+ * outPath.  Its stderr (which holds the sample's deliberate errors) is
+ * discarded.  Returns its exit status, or -1 if it could not be run.
+ */
+static int runAssembler(char * argv[], const char * outPath)
+{
+    int   status;
+    pid_t pid;
+
+    if ( (pid = fork()) < 0 )
+        return -1;
+    if ( pid == 0 )
+    {
+        int out = open(outPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+
+        if ( out < 0 || err < 0 )
+            _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if ( waitpid(pid, &status, 0) < 0 )
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Returns 1 if the two files hold the same bytes (and at least one). */
+static int sameFiles(const char * path1, const char * path2)
+{
+    FILE * fp1 = fopen(path1, "rb"), * fp2 = fopen(path2, "rb");
+    int    c1 = EOF, c2 = EOF;
+    long   length = 0;
+
+    if ( fp1 != NULL && fp2 != NULL )
+        do
+        {
+            c1 = getc(fp1);
+            c2 = getc(fp2);
+            length++;
+        } while ( c1 == c2 && c1 != EOF );
+    if ( fp1 != NULL )
+        fclose(fp1);
+    if ( fp2 != NULL )
+        fclose(fp2);
+    return fp1 != NULL && fp2 != NULL && c1 == c2 && length > 1;
+}
+
+int main (int argc, char * argv[])
+{
+    char formatArg[32];
+    int  errors = 0, f;
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+
+    printf("About to test disassembling and reassembling %s:\n", SAMPLE);
+    for ( f = 0; f < COUNT(formats); f++ )
+    {
+        char * assemble[] = { "./assembler", formatArg, SAMPLE, NULL };
+        char * disassemble[] = { "./assembler", "--disassemble", formatArg,
+                                 WORDS, NULL };
+        char * reassemble[] = { "./assembler", formatArg, SOURCE, NULL };
+        int    same;
+
+        snprintf(formatArg, sizeof(formatArg), "--format=%s", formats[f]);
+        runAssembler(assemble, WORDS);      /* the sample has errors */
+        same = runAssembler(disassemble, SOURCE) == 0 &&
+               runAssembler(reassemble, REASSEMBLED) == 0 &&
+               sameFiles(WORDS, REASSEMBLED) &&
+               (f > 0 || sameFiles(WORDS, SAMPLE_OUT));
+        printf("\t%-16s %s\n", formatArg, same ? "ok" : "DIFFERS");
+        if ( ! same )
+            errors++;
+    }
+
+    printf("About to test a word that is not an instruction:\n");
+    {
+        char * assemble[] = { "./assembler", "--format=hex",
+                              "--emit-symbols=" SYMBOLS, WORD_SOURCE, NULL };
+        char * disassemble[] = { "./assembler", "--disassemble",
+                                 "--format=hex", "--symbols=" SYMBOLS,
+                                 WORDS, NULL };
+        char * reassemble[] = { "./assembler", "--format=hex", SOURCE,
+                                NULL };
+        int    assembled, same;
+
+        assembled = writeFile(WORD_SOURCE, wordSource) &&
+                    writeFile(WORD_HEX, wordHex) &&
+                    runAssembler(assemble, WORDS) == 0 &&
+                    sameFiles(WORDS, WORD_HEX);
+        same = assembled && runAssembler(disassemble, SOURCE) == 0 &&
+               runAssembler(reassemble, REASSEMBLED) == 0 &&
+               sameFiles(REASSEMBLED, WORD_HEX);
+        printf("\t%-16s %s\n", "assembled", assembled ? "ok" : "DIFFERS");
+        printf("\t%-16s %s\n", "reassembled", same ? "ok" : "DIFFERS");
+        errors += ! assembled + ! same;
+    }
+
+    (void) unlink(WORDS);
+    (void) unlink(SOURCE);
+    (void) unlink(REASSEMBLED);
+    (void) unlink(WORD_SOURCE);
+    (void) unlink(WORD_HEX);
+    (void) unlink(SYMBOLS);
+    printf("%s: %d outputs differ.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    return errors == 0 ? 0 : 1;
+}
@@ -14,6 +14,7 @@
  *
  * Creation Date:  2/22/2022
  *        modified: 2/22/2022        complete tests for static and dynamic tables
+ *        modified: 10/19/2026       static table uses struct-of-arrays layout
  *        
  * 
  */
@@ -32,19 +33,32 @@ int main(int argc, char * argv[])
     /* Create 2 tables, one static and one dynamic, for testing purposes */
     printf("===== Testing with static table =====\n");
 
-    /* Create a static array of label entries for initial testing. */
-    LabelEntry staticEntries[5];
-    staticEntries[0].label = "Label1";
-    staticEntries[0].address = 1000;
-    staticEntries[1].label = "Label2";
-    staticEntries[1].address = 2000;
-    staticEntries[2].label = "Label3";
-    staticEntries[2].address = 3000;
-    /* Initialize testTable1 to use the static array above. */
+    /* Create static arrays of label entries for initial testing.  The
+     * table keeps its label names in one string pool and finds them by
+     * hash and length; with no hash index (numSlots == 0) it searches
+     * the entries one by one.
+     */
+    static char staticPool[] = "Label1\0Label2\0Label3";
+    unsigned int staticHashes[5], staticOffsets[5], staticLengths[5];
+    int staticAddresses[5];
+    int i;
+    for ( i = 0; i < 3; i++ )
+    {
+        staticOffsets[i] = 7 * i;
+        staticHashes[i] = labelHash(staticPool + staticOffsets[i],
+                                    &staticLengths[i]);
+        staticAddresses[i] = 1000 * (i + 1);
+    }
+    /* Initialize testTable1 to use the static arrays above. */
     LabelTableArrayList testTable1;      /* table with static entries */
+    tableInit(&testTable1);
     testTable1.capacity = 5;
     testTable1.nbrLabels = 2;
-    testTable1.entries = staticEntries;
+    testTable1.hashes = staticHashes;
+    testTable1.offsets = staticOffsets;
+    testTable1.lengths = staticLengths;
+    testTable1.addresses = staticAddresses;
+    testTable1.pool = staticPool;
 
     /* Test printLabels and findLabelAddr with static testTable1.
      *  =>  DO NOT TEST tableInit, addLabel, or tableResize WITH STATIC TABLE!
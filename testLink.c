@@ -0,0 +1,350 @@
+/*
+ * This is a test driver for separate assembly.  It writes two units
+ * that refer to each other's labels (with j, jal, beq, and bne, forward
+ * and back) and runs ./assembler to check, in every output format, that
+ *      - assembling each unit with --object and linking them with
+ *        --link (with one thread and with several) produces exactly the
+ *        bytes that assembling the two units as one file does, and
+ *      - assembling that file with its label definitions removed, using
+ *        the --emit-symbols map of the original with --symbols, does too.
+ * It then damages copies of the symbol map and of an object file (an
+ * index slot or a name outside the arrays, a truncated file) and checks
+ * that --symbols and --link reject each one with an error.  It prints
+ * each result and exits with status 1 if any output differs or any
+ * damaged file is accepted.
+ *
+ * The assembler must already have been built in the current directory.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "assembler.h"
+#include "symbolMap.h"
+#include "objectFile.h"
+
+#define UNIT1      "testLink1.mips"
+#define UNIT2      "testLink2.mips"
+#define OBJECT1    "testLink1.obj"
+#define OBJECT2    "testLink2.obj"
+#define WHOLE      "testLink.mips"
+#define UNLABELED  "testLinkUnlabeled.mips"
+#define SYMBOLS    "testLink.sym"
+#define EXPECTED   "testLink.expected"
+#define ACTUAL     "testLink.actual"
+#define DAMAGED    "testLinkDamaged"
+
+static const char * unit1 =
+    "        .globl main\n"
+    "main:   addi $t0, $zero, 3\n"
+    "loop:   beq $t0, $zero, out     # within the unit\n"
+    "        jal helper              # into the other unit\n"
+    "        addi $t0, $t0, -1\n"
+    "        j loop\n"
+    "\n"
+    "out:    beq $t0, $zero, finish  # into the other unit\n"
+    "        j finish\n";
+
+static const char * unit2 =
+    "        .globl helper\n"
+    "        .globl finish\n"
+    "helper: add $v0, $v0, $t0\n"
+    "        bne $v0, $zero, done\n"
+    "        beq $v0, $t0, main      # back into the first unit\n"
+    "        j main\n"
+    "# a comment between functions\n"
+    "done:   jr $ra\n"
+    "finish: addi $v0, $zero, 10\n"
+    "        syscall\n";
+
+static const char * formats[] = { "binary", "hex", "raw" };
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* Writes text to path, with the label at the start of each line removed
+ * if unlabeled is 1.  Returns 1 if it could be written.
+ */
+static int writeFile(const char * path, const char * text, int unlabeled)
+{
+    FILE * fp = fopen(path, "a");
+
+    if ( fp == NULL )
+        return 0;
+    while ( *text != '\0' )
+    {
+        size_t length = strcspn(text, "\n") + 1;
+        size_t label = strcspn(text, ":\n");
+
+        if ( unlabeled && text[label] == ':' )
+            fprintf(fp, "%*s%.*s", (int) label + 1, "",
+                    (int) (length - label - 1), text + label + 1);
+        else
+            fprintf(fp, "%.*s", (int) length, text);
+        text += length;
+    }
+    return fclose(fp) == 0;
+}
+
+/* Runs ./assembler with the given arguments and its stdout sent to
+ * outPath (or discarded, if outPath is NULL).  Its stderr is discarded.
+ * Returns its exit status, or -1 if it could not be run.
+ */
+static int runAssembler(char * argv[], const char * outPath)
+{
+    int   status;
+    pid_t pid;
+
+    if ( (pid = fork()) < 0 )
+        return -1;
+    if ( pid == 0 )
+    {
+        int out = open(outPath != NULL ? outPath : "/dev/null",
+                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+
+        if ( out < 0 || err < 0 )
+            _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if ( waitpid(pid, &status, 0) < 0 )
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Returns 1 if the two files hold the same bytes (and at least one). */
+static int sameFiles(const char * path1, const char * path2)
+{
+    FILE * fp1 = fopen(path1, "rb"), * fp2 = fopen(path2, "rb");
+    int    c1 = EOF, c2 = EOF;
+    long   length = 0;
+
+    if ( fp1 != NULL && fp2 != NULL )
+        do
+        {
+            c1 = getc(fp1);
+            c2 = getc(fp2);
+            length++;
+        } while ( c1 == c2 && c1 != EOF );
+    if ( fp1 != NULL )
+        fclose(fp1);
+    if ( fp2 != NULL )
+        fclose(fp2);
+    return fp1 != NULL && fp2 != NULL && c1 == c2 && length > 1;
+}
+
+/* Reads the whole file at path into memory, which the caller must free.
+ * Returns it, with its length in *size, or NULL if it cannot be read.
+ */
+static unsigned char * readWhole(const char * path, long * size)
+{
+    FILE          * fp = fopen(path, "rb");
+    unsigned char * data = NULL;
+
+    if ( fp == NULL )
+        return NULL;
+    if ( fseek(fp, 0, SEEK_END) == 0 && (*size = ftell(fp)) > 0 &&
+         fseek(fp, 0, SEEK_SET) == 0 && (data = malloc(*size)) != NULL &&
+         fread(data, 1, *size, fp) != (size_t) *size )
+    {
+        free(data);
+        data = NULL;
+    }
+    fclose(fp);
+    return data;
+}
+
+/* Returns the byte position of the first slot of the index of a table
+ * of nbrLabels labels whose arrays start at start, whose value is (if
+ * empty is 1) or is not (if empty is 0) the empty marker, 0.
+ */
+static long findSlot(const unsigned char * data, long start,
+                     unsigned int nbrLabels, unsigned int numSlots,
+                     int empty)
+{
+    long         position = start + 16L * nbrLabels;
+    unsigned int i;
+    int          slot;
+
+    for ( i = 0; i < numSlots; i++, position += 4 )
+    {
+        memcpy(&slot, data + position, sizeof(slot));
+        if ( (slot == 0) == empty )
+            break;
+    }
+    return position;
+}
+
+/* Writes a copy of from, with the unsigned int at byte position changed
+ * to value (or, if position is -1, without its last 4 bytes), to DAMAGED;
+ * runs ./assembler with args; and prints and returns whether it rejected
+ * the copy with an error.
+ */
+static int checkDamaged(const char * what, const char * from, long position,
+                        unsigned int value, char * args[])
+{
+    long            size;
+    unsigned char * data = readWhole(from, &size);
+    FILE          * fp;
+    int             rejected = 0;
+
+    if ( data != NULL )
+    {
+        if ( position < 0 )
+            size -= 4;
+        else
+            memcpy(data + position, &value, sizeof(value));
+        if ( (fp = fopen(DAMAGED, "wb")) != NULL )
+        {
+            rejected = fwrite(data, 1, size, fp) == (size_t) size;
+            rejected = fclose(fp) == 0 && rejected &&
+                       runAssembler(args, NULL) == 1;
+        }
+        free(data);
+    }
+    printf("\t%-44s %s\n", what, rejected ? "rejected" : "NOT REJECTED");
+    return rejected;
+}
+
+/* Damages copies of SYMBOLS and OBJECT1 in several ways, and checks
+ * that --symbols and --link reject each copy.  Returns the number of
+ * copies that were not rejected.
+ */
+static int checkDamagedFiles(void)
+{
+    char            * symbols[] = { "./assembler", "--symbols=" DAMAGED,
+                                    UNLABELED, NULL };
+    char            * link[] = { "./assembler", "--link", DAMAGED, OBJECT2,
+                                 NULL };
+    long              size, start = sizeof(SymbolMapHeader);
+    unsigned char   * map = readWhole(SYMBOLS, &size);
+    unsigned char   * object = readWhole(OBJECT1, &size);
+    SymbolMapHeader   header;
+    ObjectHeader      objectHeader;
+    ObjectSection   * globals, * externals;
+    unsigned int      n, pool;
+    int               errors = 0;
+
+    if ( map == NULL || object == NULL )
+    {
+        printf("\tthe files could not be read\n");
+        free(map);
+        free(object);
+        return 1;
+    }
+    memcpy(&header, map, sizeof(header));
+    memcpy(&objectHeader, object, sizeof(objectHeader));
+    n = header.nbrLabels;
+    pool = header.poolSize;
+    globals = &objectHeader.sections[OBJECT_GLOBALS];
+    externals = &objectHeader.sections[OBJECT_EXTERNALS];
+
+    errors += ! checkDamaged("map: an index slot past the labels", SYMBOLS,
+                             findSlot(map, start, n, header.numSlots, 0),
+                             n + 1, symbols);
+    errors += ! checkDamaged("map: no empty index slot", SYMBOLS,
+                             findSlot(map, start, n, header.numSlots, 1),
+                             1, symbols);
+    errors += ! checkDamaged("map: a name offset past the pool", SYMBOLS,
+                             start + 4L * n, pool, symbols);
+    errors += ! checkDamaged("map: a name running past the pool", SYMBOLS,
+                             start + 8L * n, pool, symbols);
+    errors += ! checkDamaged("map: truncated", SYMBOLS, -1, 0, symbols);
+    errors += ! checkDamaged("object: a global name past the pool",
+                             OBJECT1, globals->offset + 4L * globals->count,
+                             globals->poolSize, link);
+    errors += ! checkDamaged("object: an external slot past the labels",
+                             OBJECT1, findSlot(object, externals->offset,
+                                               externals->count,
+                                               externals->numSlots, 0),
+                             externals->count + 1, link);
+    free(map);
+    free(object);
+    return errors;
+}
+
+/* Runs ./assembler with args, and prints and returns whether it
+ * succeeded and printed what EXPECTED holds.
+ */
+static int check(const char * what, char * args[])
+{
+    int same;
+
+    (void) unlink(ACTUAL);
+    same = runAssembler(args, ACTUAL) == 0 && sameFiles(EXPECTED, ACTUAL);
+    printf("\t%-36s %s\n", what, same ? "ok" : "DIFFERS");
+    return same;
+}
+
+int main (int argc, char * argv[])
+{
+    static const char * files[] = { UNIT1, UNIT2, OBJECT1, OBJECT2, WHOLE,
+                                    UNLABELED, SYMBOLS, EXPECTED, ACTUAL,
+                                    DAMAGED };
+    char   formatArg[32];
+    char   objectArg1[] = "--object=" OBJECT1;
+    char   objectArg2[] = "--object=" OBJECT2;
+    char   emitArg[] = "--emit-symbols=" SYMBOLS;
+    char   symbolsArg[] = "--symbols=" SYMBOLS;
+    int    errors = 0, f, i;
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+    for ( i = 0; i < COUNT(files); i++ )
+        (void) unlink(files[i]);
+    if ( ! writeFile(UNIT1, unit1, 0) || ! writeFile(UNIT2, unit2, 0) ||
+         ! writeFile(WHOLE, unit1, 0) || ! writeFile(WHOLE, unit2, 0) ||
+         ! writeFile(UNLABELED, unit1, 1) || ! writeFile(UNLABELED, unit2, 1) )
+    {
+        printError("Error: cannot write the test programs.\n");
+        return 1;
+    }
+
+    for ( f = 0; f < COUNT(formats); f++ )
+    {
+        char * whole[] = { "./assembler", formatArg, emitArg, WHOLE, NULL };
+        char * object1[] = { "./assembler", objectArg1, UNIT1, NULL };
+        char * object2[] = { "./assembler", objectArg2, UNIT2, NULL };
+        char * link1[] = { "./assembler", "--link", formatArg,
+                           "--threads=1", OBJECT1, OBJECT2, NULL };
+        char * link4[] = { "./assembler", "--link", formatArg,
+                           "--threads=4", OBJECT1, OBJECT2, NULL };
+        char * symbols[] = { "./assembler", formatArg, symbolsArg,
+                             UNLABELED, NULL };
+
+        snprintf(formatArg, sizeof(formatArg), "--format=%s", formats[f]);
+        printf("About to test separate assembly with %s:\n", formatArg);
+        if ( runAssembler(whole, EXPECTED) != 0 ||
+             runAssembler(object1, NULL) != 0 ||
+             runAssembler(object2, NULL) != 0 )
+        {
+            printf("\tthe units could not be assembled\n");
+            errors++;
+            continue;
+        }
+        errors += ! check("--link with one thread", link1);
+        errors += ! check("--link with four threads", link4);
+        errors += ! check("--symbols, without label definitions",
+                          symbols);
+    }
+
+    /* Damaged copies of the last symbol map and of the first unit. */
+    printf("About to test damaged symbol maps and object files:\n");
+    errors += checkDamagedFiles();
+
+    for ( i = 0; i < COUNT(files); i++ )
+        (void) unlink(files[i]);
+    printf("%s: %d checks failed.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,185 @@
+/*
+ * This is a test driver for the different ways the assembler produces
+ * its output.  It writes a program with labels on lines of their own,
+ * blank and comment-only lines, directives, and forward and backward
+ * branches and jumps, then runs ./assembler on it in every output
+ * format and checks that --pipeline, --stream, --max-memory (small
+ * enough to force streaming), and --output=FILE with one and with
+ * several threads all produce exactly the bytes the default path
+ * prints.  It prints each result and exits with status 1 if any output
+ * differs.
+ *
+ * The assembler must already have been built in the current directory.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "assembler.h"
+
+#define NUM_BLOCKS  4000
+#define SOURCE      "testOutputPaths.mips"
+#define EXPECTED    "testOutputPaths.expected"
+#define ACTUAL      "testOutputPaths.actual"
+
+/* The options of each path, after the format; "-" is replaced by an
+ * --output=ACTUAL option, for the paths that write the file themselves.
+ */
+static const char * paths[][3] = {
+    { "--pipeline", NULL, NULL },
+    { "--stream", NULL, NULL },
+    { "--max-memory=1K", NULL, NULL },
+    { "-", "--threads=1", NULL },
+    { "-", "--threads=4", NULL },
+    { "-", "--pipeline", NULL },
+    { "-", "--stream", NULL }
+};
+
+static const char * formats[] = { "binary", "hex", "raw" };
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* Writes the test program to SOURCE.  Returns 1 if it could be written. */
+static int writeProgram(void)
+{
+    FILE * fp = fopen(SOURCE, "w");
+    int    i;
+
+    if ( fp == NULL )
+        return 0;
+    fprintf(fp, "        .globl main\nmain:\n");
+    for ( i = 0; i < NUM_BLOCKS; i++ )
+    {
+        fprintf(fp, "\n# block %d\nblock%d:\n", i, i);
+        fprintf(fp, "        add $t0, $t1, $t2       # comment\n");
+        fprintf(fp, "        beq $t0, $zero, block%d\n", i + 1);
+        fprintf(fp, "        lw $t1, %d($t2)\n", 4 * (i % 100));
+        fprintf(fp, "skip%d:  sw $t1, 0($sp)\n", i);
+        fprintf(fp, "        bne $t1, $t2, block%d\n", i / 2);
+        fprintf(fp, "        j skip%d\n", (i * 7) % NUM_BLOCKS);
+        fprintf(fp, "        jal main\n");
+    }
+    fprintf(fp, "block%d:\n        jr $ra\n", NUM_BLOCKS);
+    return fclose(fp) == 0;
+}
+
+/* Runs ./assembler with the given arguments and its stdout sent to
+ * outPath (or discarded, if outPath is NULL).  Its stderr, which holds
+ * only statistics here, is discarded.  Returns its exit status, or -1 if
+ * it could not be run.
+ */
+static int runAssembler(char * argv[], const char * outPath)
+{
+    int   status;
+    pid_t pid;
+
+    if ( (pid = fork()) < 0 )
+        return -1;
+    if ( pid == 0 )
+    {
+        int out = open(outPath != NULL ? outPath : "/dev/null",
+                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+
+        if ( out < 0 || err < 0 )
+            _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if ( waitpid(pid, &status, 0) < 0 )
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Returns 1 if the two files hold the same bytes (and at least one). */
+static int sameFiles(const char * path1, const char * path2)
+{
+    FILE * fp1 = fopen(path1, "rb"), * fp2 = fopen(path2, "rb");
+    int    c1 = EOF, c2 = EOF;
+    long   length = 0;
+
+    if ( fp1 != NULL && fp2 != NULL )
+        do
+        {
+            c1 = getc(fp1);
+            c2 = getc(fp2);
+            length++;
+        } while ( c1 == c2 && c1 != EOF );
+    if ( fp1 != NULL )
+        fclose(fp1);
+    if ( fp2 != NULL )
+        fclose(fp2);
+    return fp1 != NULL && fp2 != NULL && c1 == c2 && length > 1;
+}
+
+int main (int argc, char * argv[])
+{
+    char formatArg[32];
+    char outputArg[] = "--output=" ACTUAL;
+    int  errors = 0, f, p, i;
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+    if ( ! writeProgram() )
+    {
+        printError("Error: cannot write file %s.\n", SOURCE);
+        return 1;
+    }
+
+    for ( f = 0; f < COUNT(formats); f++ )
+    {
+        char * defaultArgs[] = { "./assembler", formatArg, SOURCE, NULL };
+
+        snprintf(formatArg, sizeof(formatArg), "--format=%s", formats[f]);
+        printf("About to test the output paths with %s:\n", formatArg);
+        if ( runAssembler(defaultArgs, EXPECTED) != 0 )
+        {
+            printf("\tthe default path failed\n");
+            errors++;
+            continue;
+        }
+        for ( p = 0; p < COUNT(paths); p++ )
+        {
+            char * args[8];
+            int    numArgs = 0, toFile = 0, status, same;
+
+            args[numArgs++] = "./assembler";
+            args[numArgs++] = formatArg;
+            for ( i = 0; i < 3 && paths[p][i] != NULL; i++ )
+            {
+                toFile |= strcmp(paths[p][i], "-") == SAME;
+                args[numArgs++] = strcmp(paths[p][i], "-") == SAME ?
+                                  outputArg : (char *) paths[p][i];
+            }
+            args[numArgs++] = SOURCE;
+            args[numArgs] = NULL;
+
+            (void) unlink(ACTUAL);
+            status = runAssembler(args, toFile ? NULL : ACTUAL);
+            same = status == 0 && sameFiles(EXPECTED, ACTUAL);
+            printf("\t");
+            for ( i = 2; i < numArgs - 1; i++ )
+                printf("%s ", args[i]);
+            printf("%s\n", same ? "ok" : "DIFFERS");
+            if ( ! same )
+                errors++;
+        }
+    }
+
+    (void) unlink(SOURCE);
+    (void) unlink(EXPECTED);
+    (void) unlink(ACTUAL);
+    printf("%s: %d outputs differ.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,169 @@
+/*
+ * This is a test driver for the field packing kernels (packFields.c).
+ * It checks that every kernel this processor supports packs exactly the
+ * same words as packFields, and that the fields decodeLine produces
+ * pack into the same words the assembler has always printed (taken from
+ * smallSampleTestfile.mips.out).  It also checks that an instruction
+ * without operands decodes when it ends the input with no newline.  It
+ * prints each result and exits with status 1 if any word differs.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+
+#define NUM_RANDOM_BLOCKS 10000
+
+/* Instructions from smallSampleTestfile.mips and their expected words. */
+static const char * sampleLines[] = {
+    "lw $a0, 0($t0)", "addi $t0, $zero, 0", "slt $t2, $a0, $t1",
+    "add $t0, $t1, $t0", "sll $t1, $t2, 10", "srl $t1, $t2, 10",
+    "jr $s0", "add $s1, $s2, $s3", "nor $t1, $t2, $a1",
+    "sltu $t1, $t2, $a2", "bne $t1, $t2, 100", "lui $t1, 100",
+    "sw $t1, 100($t2)", "jal 1000", "addi $t1, $t1, -1"
+};
+static const char * sampleWords[] = {
+    "10001101000001000000000000000000", "00100000000010000000000000000000",
+    "00000000100010010101000000101010", "00000001001010000100000000100000",
+    "00000000000010100100101010000000", "00000000000010100100101010000010",
+    "00000010000000000000000000001000", "00000010010100111000100000100000",
+    "00000001010001010100100000100111", "00000001010001100100100000101011",
+    "00010101001010100000000001100100", "00111100000010010000000001100100",
+    "10101101010010010000000001100100", "00001100000000000000001111101000",
+    "00100001001010011111111111111111"
+};
+
+/* Lines that end with the instruction name. */
+static const char * endLines[] = { "nop", "syscall", "loop: nop", "  nop  " };
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+static unsigned int seed = 12345;
+
+/* Returns a random number with the given number of bits. */
+static unsigned int randomBits(int bits)
+{
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return bits == 32 ? seed : seed & ((1u << bits) - 1);
+}
+
+/* Packs block with every supported kernel and compares the words with
+ * packFields.  Returns the number of words that differ.
+ */
+static int checkBlock(const FieldBlock * block, const InstrFields * fields,
+                      int * kernelUsed)
+{
+    unsigned int words[PACK_BLOCK_SIZE];
+    int kernel, i, errors = 0;
+
+    for ( kernel = 0; kernel < NUM_PACK_KERNELS; kernel++ )
+    {
+        if ( ! packBlockWith(kernel, block, words) )
+            continue;
+        kernelUsed[kernel] = 1;
+        for ( i = 0; i < block->count; i++ )
+            if ( words[i] != packFields(&fields[i]) )
+            {
+                printf("\t%s: word %d is %08x, expected %08x\n",
+                       packKernelName(kernel), i, words[i],
+                       packFields(&fields[i]));
+                errors++;
+            }
+    }
+    return errors;
+}
+
+int main (int argc, char * argv[])
+{
+    LabelTableArrayList table;
+    FieldBlock   block;
+    InstrFields  fields[PACK_BLOCK_SIZE];
+    int          kernelUsed[NUM_PACK_KERNELS] = { 0 };
+    int          errors = 0, b, i;
+    char         line[BUFSIZ];
+    char         binary[BINARY_WORD_LENGTH + 1];
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+    tableInit(&table);
+
+    printf("packBlock uses the %s kernel on this processor.\n",
+           packKernelName(packKernelInUse()));
+
+    /* Random fields of every width, in blocks of every size. */
+    printf("About to test %d random blocks with every kernel:\n",
+           NUM_RANDOM_BLOCKS);
+    for ( b = 0; b < NUM_RANDOM_BLOCKS; b++ )
+    {
+        block.count = 0;
+        for ( i = 0; i < b % PACK_BLOCK_SIZE + 1; i++ )
+        {
+            fields[i].opcode = randomBits(6);
+            fields[i].rs = randomBits(5);
+            fields[i].rt = randomBits(5);
+            fields[i].rd = randomBits(5);
+            fields[i].shamt = randomBits(5);
+            fields[i].funct = randomBits(6);
+            fields[i].imm = randomBits(16);
+            blockAdd(&block, &fields[i]);
+        }
+        errors += checkBlock(&block, fields, kernelUsed);
+    }
+    for ( i = 0; i < NUM_PACK_KERNELS; i++ )
+        printf("\t%s: %s\n", packKernelName(i),
+               kernelUsed[i] ? "tested" : "not supported here");
+
+    /* Decoded sample instructions, against the words printed before. */
+    printf("About to test decoded sample instructions:\n");
+    block.count = 0;
+    for ( i = 0; i < COUNT(sampleLines); i++ )
+    {
+        strcpy(line, sampleLines[i]);
+        if ( decodeLine(line, i + 1, 4 * (i + 1), &table, &fields[i],
+                        NULL) != ASM_OK )
+        {
+            printf("\t%s: could not be decoded\n", sampleLines[i]);
+            errors++;
+            continue;
+        }
+        formatBinaryWord(packFields(&fields[i]), binary);
+        binary[32] = '\0';
+        printf("\t%-20s %s %s\n", sampleLines[i], binary,
+               strcmp(binary, sampleWords[i]) == SAME ? "ok" : "DIFFERS");
+        if ( strcmp(binary, sampleWords[i]) != SAME )
+            errors++;
+        blockAdd(&block, &fields[i]);
+    }
+    errors += checkBlock(&block, fields, kernelUsed);
+
+    /* Instructions without operands on a last line with no newline,
+     * in a buffer that still holds the end of a longer line read
+     * before it (as fgets leaves it).
+     */
+    printf("About to test operandless instructions at the end of the "
+           "input:\n");
+    for ( i = 0; i < COUNT(endLines); i++ )
+    {
+        int result;
+
+        strcpy(line, "add $t0, $t1, $t2\n");
+        strcpy(line, endLines[i]);
+        result = decodeLine(line, i + 1, 4 * (i + 1), &table, &fields[0],
+                            NULL);
+        printf("\t%-20s %s\n", endLines[i],
+               result == ASM_OK ? "ok" : "NOT DECODED");
+        if ( result != ASM_OK )
+            errors++;
+    }
+
+    printf("%s: %d words differ.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    tableFree(&table);
+    return errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,90 @@
+/*
+ * This is a test driver for the way pass1 and pass2 give lines their
+ * addresses.  Pass1 sizes each line with instructionSize, before it is
+ * decoded; pass2, pipeline, streamPass, and objectPass advance by
+ * addressStep of what decodeLine returned.  Labels only point at the
+ * right instructions if the two agree, so for every kind of line
+ * (blank, comment-only, label-only, directive, .word, valid and invalid
+ * instructions) this checks that they do, both with and without
+ * setLineAddresses.  It prints each result and exits with status 1 if
+ * any line differs.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+
+static const char * testLines[] = {
+    "",
+    "\n",
+    "   \t\n",
+    "# comment\n",
+    "        # indented comment\n",
+    "label:\n",
+    "label:   # comment\n",
+    "label:\t \n",
+    ".globl main\n",
+    "main:   .globl main     # comment\n",
+    "        .unknown\n",
+    "        .word 0x12345678\n",
+    "data:   .word -1                # comment\n",
+    "        .word",
+    "        .wordy 3\n",
+    "        add $t0, $t1, $t2\n",
+    "loop:   add $t0, $t1, $t2      # comment\n",
+    "loop:add $t0,$t1,$t2\n",
+    "        lw $t0, 4($t1)\n",
+    "        beq $t0, $zero, later\n",
+    "        j later",
+    "        nop\n",
+    "        syscall",
+    "        elf $t1, $t2, $t6       # invalid instruction\n",
+    "        add $t1, $t2, $a9       # invalid register\n",
+    "        add $t1, $t2\n"
+};
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+int main (int argc, char * argv[])
+{
+    LabelTableArrayList table;
+    InstrFields  fields;
+    LabelRef     unresolved;
+    char         line[BUFSIZ];
+    int          errors = 0, lineAddresses, i;
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+    tableInit(&table);
+
+    for ( lineAddresses = 0; lineAddresses <= 1; lineAddresses++ )
+    {
+        setLineAddresses(lineAddresses);
+        printf("About to test line sizes %s line addresses:\n",
+               lineAddresses ? "with" : "without");
+        for ( i = 0; i < COUNT(testLines); i++ )
+        {
+            const char * shown = testLines[i] + strspn(testLines[i], " \t");
+            int size = instructionSize(testLines[i], strlen(testLines[i]));
+            int step;
+
+            /* Errors for the invalid lines go to stderr, as usual. */
+            strcpy(line, testLines[i]);
+            step = addressStep(decodeLine(line, i + 1, 4 * i, &table,
+                                          &fields, &unresolved));
+            printf("\t%-48.*s %d %d %s\n", (int) strcspn(shown, "\n"),
+                   shown, size, step, size == step ? "ok" : "DIFFERS");
+            if ( size != step )
+                errors++;
+        }
+    }
+
+    printf("%s: %d lines differ.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    tableFree(&table);
+    return errors == 0 ? 0 : 1;
+}
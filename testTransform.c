@@ -0,0 +1,419 @@
+/*
+ * This is a test driver for the passes that rewrite the decoded program
+ * (see transform.h).  It writes two small programs with loops, calls,
+ * loads used right away, waste for the peephole patterns, and
+ * unreachable code, and runs ./assembler on them to check that
+ *      - -O, --schedule, and --prune-unreachable (alone and together)
+ *        change the words, but not the registers --run leaves;
+ *      - --fill-delay-slots keeps every label, branch, and jump, with
+ *        each branch and jump still reaching its label (as --disassemble
+ *        names them from the --emit-symbols map), and only moves
+ *        instructions and adds nops; and
+ *      - --cfg-dot writes the graph, with the unreachable blocks dashed,
+ *        without changing the words.
+ * It prints each result and exits with status 1 if any check fails.
+ *
+ * The assembler must already have been built in the current directory.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "assembler.h"
+
+#define CALLS      "testTransformCalls.mips"
+#define BLOCKS     "testTransformBlocks.mips"
+#define SYMBOLS    "testTransform.sym"
+#define DOT        "testTransform.dot"
+#define EXPECTED   "testTransform.expected"
+#define ACTUAL     "testTransform.actual"
+#define LISTING    "testTransform.listing"
+
+#define MAX_LINES    64         /* in the disassembly of a program */
+#define LINE_LENGTH  80
+
+/* g returns past the jr $ra after the jal that called it, so turning
+ * "jal g; jr $ra" into "j g" would skip the addi at ret.  Since that
+ * jump is not one the control-flow graph can follow, this program is
+ * not pruned.
+ */
+static const char * calls =
+    "        .globl main\n"
+    "main:   addi $sp, $sp, -8\n"
+    "        sw $ra, 4($sp)\n"
+    "        addi $t0, $zero, 5\n"
+    "        add $t0, $t0, $zero         # a move to itself\n"
+    "        sw $t0, 0($sp)\n"
+    "        j first                     # a jump to a jump\n"
+    "loop:   lw $t1, 0($sp)\n"
+    "        add $t2, $t2, $t1           # uses the load right away\n"
+    "        addi $t1, $t1, -1\n"
+    "        sw $t1, 0($sp)\n"
+    "        bne $t1, $zero, loop\n"
+    "        j next                      # a jump to the next instruction\n"
+    "next:   jal f\n"
+    "ret:    addi $t3, $t3, 100\n"
+    "        lw $ra, 4($sp)\n"
+    "        addi $sp, $sp, 8\n"
+    "        jr $ra\n"
+    "first:  j loop\n"
+    "f:      jal g                       # not a tail call\n"
+    "        jr $ra\n"
+    "        addi $t4, $t4, 7\n"
+    "        j ret\n"
+    "g:      lw $t5, 0($sp)\n"
+    "        addi $t6, $t5, 1\n"
+    "        addi $ra, $ra, 4\n"
+    "        jr $ra\n";
+
+static const char * blocks =
+    "        .globl main\n"
+    "main:   addi $t0, $zero, 4\n"
+    "        addi $sp, $sp, -16\n"
+    "loop:   sw $t0, 0($sp)\n"
+    "        lw $t1, 0($sp)\n"
+    "        add $t2, $t2, $t1           # uses the load right away\n"
+    "        or $t3, $t3, $zero          # a move to itself\n"
+    "        beq $t1, $zero, done\n"
+    "        addi $t0, $t0, -1\n"
+    "        slt $t4, $zero, $t0\n"
+    "        bne $t4, $zero, loop\n"
+    "        j done\n"
+    "        addi $t9, $zero, 1          # never reached\n"
+    "unused: lw $t8, 4($sp)              # reached only if $s1 is 0\n"
+    "        j unused\n"
+    "done:   addi $sp, $sp, 16\n"
+    "        add $s1, $t2, $t3\n"
+    "        beq $s1, $zero, unused\n"
+    "        jr $ra\n";
+
+/* The passes to run on each program, and check with --run. */
+typedef struct {
+        const char * program;
+        const char * options[4];
+} Case;
+
+static const Case cases[] = {
+    { CALLS, { "-O", NULL } },
+    { CALLS, { "--schedule", NULL } },
+    { CALLS, { "-O", "--schedule", NULL } },
+    { BLOCKS, { "-O", NULL } },
+    { BLOCKS, { "--schedule", NULL } },
+    { BLOCKS, { "--prune-unreachable", NULL } },
+    { BLOCKS, { "--prune-unreachable", "-O", "--schedule", NULL } }
+};
+
+static const char * programs[] = { CALLS, BLOCKS };
+
+static const char * noOptions[] = { NULL };
+static const char * delaySlots[] = { "--fill-delay-slots", NULL };
+
+/* The instructions that end a basic block. */
+static const char * control[] = { "beq", "bne", "j", "jal", "jr" };
+
+#define NOP  "sll $zero, $zero, 0"
+
+#define COUNT(array) ((int) (sizeof(array) / sizeof(array[0])))
+
+/* The disassembly of a program: its labels and control transfers, in
+ * order, and its other instructions (except nops), sorted.
+ */
+typedef struct {
+        char control[MAX_LINES][LINE_LENGTH];
+        char other[MAX_LINES][LINE_LENGTH];
+        int  numControl, numOther;
+} Listing;
+
+/* Writes text to path.  Returns 1 if it could be written. */
+static int writeFile(const char * path, const char * text)
+{
+    FILE * fp = fopen(path, "w");
+
+    if ( fp == NULL )
+        return 0;
+    fputs(text, fp);
+    return fclose(fp) == 0;
+}
+
+/* Runs ./assembler with the given arguments and its stdout sent to
+ * outPath (or discarded, if outPath is NULL).  Its stderr, which holds
+ * only statistics here, is discarded.  Returns its exit status, or -1 if
+ * it could not be run.
+ */
+static int runAssembler(char * argv[], const char * outPath)
+{
+    int   status;
+    pid_t pid;
+
+    if ( (pid = fork()) < 0 )
+        return -1;
+    if ( pid == 0 )
+    {
+        int out = open(outPath != NULL ? outPath : "/dev/null",
+                       O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        int err = open("/dev/null", O_WRONLY);
+
+        if ( out < 0 || err < 0 )
+            _exit(127);
+        dup2(out, STDOUT_FILENO);
+        dup2(err, STDERR_FILENO);
+        execv(argv[0], argv);
+        _exit(127);
+    }
+    if ( waitpid(pid, &status, 0) < 0 )
+        return -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+/* Runs ./assembler with the options (up to a NULL), then the other
+ * arguments (up to a NULL), and its stdout sent to outPath.  Returns its
+ * exit status, or -1 if it could not be run.
+ */
+static int runWith(const char * const options[], const char * const args[],
+                   const char * outPath)
+{
+    char * argv[16];
+    int    argc = 0, i;
+
+    argv[argc++] = "./assembler";
+    for ( i = 0; options[i] != NULL; i++ )
+        argv[argc++] = (char *) options[i];
+    for ( i = 0; args[i] != NULL; i++ )
+        argv[argc++] = (char *) args[i];
+    argv[argc] = NULL;
+    return runAssembler(argv, outPath);
+}
+
+/* Returns 1 if the two files hold the same bytes (and at least one). */
+static int sameFiles(const char * path1, const char * path2)
+{
+    FILE * fp1 = fopen(path1, "rb"), * fp2 = fopen(path2, "rb");
+    int    c1 = EOF, c2 = EOF;
+    long   length = 0;
+
+    if ( fp1 != NULL && fp2 != NULL )
+        do
+        {
+            c1 = getc(fp1);
+            c2 = getc(fp2);
+            length++;
+        } while ( c1 == c2 && c1 != EOF );
+    if ( fp1 != NULL )
+        fclose(fp1);
+    if ( fp2 != NULL )
+        fclose(fp2);
+    return fp1 != NULL && fp2 != NULL && c1 == c2 && length > 1;
+}
+
+/* Returns 1 if the two files, as printed by --run, hold the same
+ * registers (and at least one).  $ra is left out: it starts just past the
+ * program, whose length the passes change.
+ */
+static int sameRegisters(const char * path1, const char * path2)
+{
+    FILE * fp1 = fopen(path1, "r"), * fp2 = fopen(path2, "r");
+    char   line1[LINE_LENGTH], line2[LINE_LENGTH];
+    int    same = fp1 != NULL && fp2 != NULL, numLines = 0;
+
+    while ( same )
+    {
+        char * read1, * read2;
+
+        while ( (read1 = fgets(line1, sizeof(line1), fp1)) != NULL &&
+                strncmp(line1, "$ra", 3) == SAME )
+            ;
+        while ( (read2 = fgets(line2, sizeof(line2), fp2)) != NULL &&
+                strncmp(line2, "$ra", 3) == SAME )
+            ;
+        if ( read1 == NULL || read2 == NULL )
+        {
+            same = read1 == read2;
+            break;
+        }
+        same = strcmp(line1, line2) == SAME;
+        numLines++;
+    }
+    if ( fp1 != NULL )
+        fclose(fp1);
+    if ( fp2 != NULL )
+        fclose(fp2);
+    return same && numLines > 0;
+}
+
+/* Returns 1 if the file at path holds text on one of its lines. */
+static int fileContains(const char * path, const char * text)
+{
+    FILE * fp = fopen(path, "r");
+    char   line[BUFSIZ];
+    int    found = 0;
+
+    if ( fp == NULL )
+        return 0;
+    while ( ! found && fgets(line, sizeof(line), fp) != NULL )
+        found = strstr(line, text) != NULL;
+    fclose(fp);
+    return found;
+}
+
+static int compareLines(const void * line1, const void * line2)
+{
+    return strcmp((const char *) line1, (const char *) line2);
+}
+
+/* Reads the output of --disassemble at path into listing.  Returns 1 if
+ * it could be read.
+ */
+static int readListing(const char * path, Listing * listing)
+{
+    FILE * fp = fopen(path, "r");
+    char   line[LINE_LENGTH];
+    int    i;
+
+    listing->numControl = listing->numOther = 0;
+    if ( fp == NULL )
+        return 0;
+    while ( fgets(line, sizeof(line), fp) != NULL )
+    {
+        size_t labelLength = strcspn(line, "\t");
+        char * instr = line + labelLength + (line[labelLength] == '\t');
+        size_t nameLength = strcspn(instr, " \n");
+        int    isControl = 0;
+
+        instr[strcspn(instr, "\n")] = '\0';
+        if ( listing->numControl + 2 > MAX_LINES ||
+             listing->numOther + 1 > MAX_LINES )
+            break;
+        if ( labelLength > 0 )
+            snprintf(listing->control[listing->numControl++], LINE_LENGTH,
+                     "%.*s", (int) labelLength, line);
+        if ( *instr == '\0' || strcmp(instr, NOP) == SAME )
+            continue;
+        for ( i = 0; i < COUNT(control); i++ )
+            isControl |= strlen(control[i]) == nameLength &&
+                         strncmp(instr, control[i], nameLength) == SAME;
+        if ( isControl )
+            strcpy(listing->control[listing->numControl++], instr);
+        else
+            strcpy(listing->other[listing->numOther++], instr);
+    }
+    fclose(fp);
+    qsort(listing->other, listing->numOther, LINE_LENGTH, compareLines);
+    return listing->numControl > 0;
+}
+
+/* Returns 1 if the two listings hold the same labels and instructions. */
+static int sameListings(const Listing * listing1, const Listing * listing2)
+{
+    int i;
+
+    if ( listing1->numControl != listing2->numControl ||
+         listing1->numOther != listing2->numOther )
+        return 0;
+    for ( i = 0; i < listing1->numControl; i++ )
+        if ( strcmp(listing1->control[i], listing2->control[i]) != SAME )
+            return 0;
+    for ( i = 0; i < listing1->numOther; i++ )
+        if ( strcmp(listing1->other[i], listing2->other[i]) != SAME )
+            return 0;
+    return 1;
+}
+
+/* Assembles program with options and --emit-symbols, and disassembles
+ * the words into listing, leaving them in wordsPath.  Returns 1 if it
+ * could.
+ */
+static int listProgram(const char * const options[], const char * program,
+                       const char * wordsPath, Listing * listing)
+{
+    const char * assembleArgs[] = { "--emit-symbols=" SYMBOLS, NULL, NULL };
+    const char * disassembleArgs[] = { "--disassemble",
+                                       "--symbols=" SYMBOLS, NULL, NULL };
+
+    assembleArgs[1] = program;
+    disassembleArgs[2] = wordsPath;
+    return runWith(options, assembleArgs, wordsPath) == 0 &&
+           runWith(noOptions, disassembleArgs, LISTING) == 0 &&
+           readListing(LISTING, listing);
+}
+
+int main (int argc, char * argv[])
+{
+    static const char * files[] = { CALLS, BLOCKS, SYMBOLS, DOT, EXPECTED,
+                                    ACTUAL, LISTING };
+    static Listing before, after;
+    int    errors = 0, c, p, i;
+
+    /* This test driver does not expect any command-line arguments. */
+    if ( argc > 1 )
+    {
+        printError("Usage:  %s\n", argv[0]);
+        return 1;
+    }
+    if ( ! writeFile(CALLS, calls) || ! writeFile(BLOCKS, blocks) )
+    {
+        printError("Error: cannot write the test programs.\n");
+        return 1;
+    }
+
+    printf("About to test the passes with --run:\n");
+    for ( c = 0; c < COUNT(cases); c++ )
+    {
+        const char * runArgs[] = { "--run", "--max-steps=100000",
+                                   cases[c].program, NULL };
+        const char * printArgs[] = { cases[c].program, NULL };
+        int          same, changed;
+
+        same = runWith(noOptions, runArgs, EXPECTED) == 0 &&
+               runWith(cases[c].options, runArgs, ACTUAL) == 0 &&
+               sameRegisters(EXPECTED, ACTUAL);
+        changed = runWith(noOptions, printArgs, EXPECTED) == 0 &&
+                  runWith(cases[c].options, printArgs, ACTUAL) == 0 &&
+                  ! sameFiles(EXPECTED, ACTUAL);
+        printf("\t%-26s", cases[c].program);
+        for ( i = 0; cases[c].options[i] != NULL; i++ )
+            printf(" %s", cases[c].options[i]);
+        printf(" %s\n", ! same ? "DIFFERS" : ! changed ? "UNCHANGED" : "ok");
+        if ( ! same || ! changed )
+            errors++;
+    }
+
+    printf("About to test --fill-delay-slots:\n");
+    for ( p = 0; p < COUNT(programs); p++ )
+    {
+        int same = listProgram(noOptions, programs[p], EXPECTED, &before) &&
+                   listProgram(delaySlots, programs[p], ACTUAL, &after) &&
+                   sameListings(&before, &after) &&
+                   ! sameFiles(EXPECTED, ACTUAL);
+
+        printf("\t%-26s %s\n", programs[p], same ? "ok" : "DIFFERS");
+        if ( ! same )
+            errors++;
+    }
+
+    printf("About to test --cfg-dot:\n");
+    for ( p = 0; p < COUNT(programs); p++ )
+    {
+        const char * dotOptions[] = { "--cfg-dot=" DOT, NULL };
+        const char * printArgs[] = { programs[p], NULL };
+        int          same;
+
+        (void) unlink(DOT);
+        same = runWith(noOptions, printArgs, EXPECTED) == 0 &&
+               runWith(dotOptions, printArgs, ACTUAL) == 0 &&
+               sameFiles(EXPECTED, ACTUAL) &&
+               fileContains(DOT, "digraph") && fileContains(DOT, "dashed");
+        printf("\t%-26s %s\n", programs[p], same ? "ok" : "DIFFERS");
+        if ( ! same )
+            errors++;
+    }
+
+    for ( i = 0; i < COUNT(files); i++ )
+        (void) unlink(files[i]);
+    printf("%s: %d checks failed.\n", errors == 0 ? "PASSED" : "FAILED",
+           errors);
+    return errors == 0 ? 0 : 1;
+}
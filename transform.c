@@ -0,0 +1,166 @@
+/*
+ * Transform: functions to take an assembled program apart and to put it
+ * back together once it has been transformed.
+ *
+ * See transform.h for a description of a program taken apart.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#include "assembler.h"
+#include "transform.h"
+#include "instrInfo.h"
+
+int codeFromImage (Code * code, const Image * image,
+                   LabelTableArrayList * table)
+{
+    long      numWords = image->numWords, i;
+    InstrInfo info;
+
+    code->numInstrs = code->numOriginal = numWords;
+    code->instrs = malloc((numWords + 1) * sizeof(CodeInstr));
+    if ( code->instrs == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        return 0;
+    }
+
+    for ( i = 0; i < numWords; i++ )
+    {
+        CodeInstr * instr = &code->instrs[i];
+
+        instrInfo(image->words[i], 4 * i, &info);
+        instr->word = image->words[i];
+        instr->lineNum = image->lineNums[i];
+        instr->origin = i;
+        instr->target = info.target;
+        instr->pinned = 0;
+    }
+
+    /* Pin what labels, branches, and jumps refer to. */
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        long address = table->addresses[i];
+
+        if ( address >= 0 && address % 4 == 0 && address / 4 < numWords )
+            code->instrs[address / 4].pinned = 1;
+    }
+    for ( i = 0; i < numWords; i++ )
+    {
+        long target = code->instrs[i].target;
+
+        if ( target >= 0 && target % 4 == 0 && target / 4 < numWords )
+            code->instrs[target / 4].pinned = 1;
+    }
+    return 1;
+}
+
+void codeReplace (Code * code, CodeInstr * instrs, long numInstrs)
+{
+    free(code->instrs);
+    code->instrs = instrs;
+    code->numInstrs = numInstrs;
+}
+
+long * codePositions (const Code * code)
+{
+    long   numOriginal = code->numOriginal, i;
+    long * positions = malloc((numOriginal + 1) * sizeof(long));
+
+    if ( positions == NULL )
+    {
+        printError("Error: cannot allocate space in memory.\n");
+        return NULL;
+    }
+
+    /* One that was deleted is replaced by the next one that was not. */
+    for ( i = 0; i < numOriginal; i++ )
+        positions[i] = -1;
+    for ( i = 0; i < code->numInstrs; i++ )
+        if ( code->instrs[i].origin >= 0 )
+            positions[code->instrs[i].origin] = i;
+    positions[numOriginal] = code->numInstrs;
+    for ( i = numOriginal - 1; i >= 0; i-- )
+        if ( positions[i] == -1 )
+            positions[i] = positions[i + 1];
+    return positions;
+}
+
+int codeToImage (Code * code, Image * image, LabelTableArrayList * table)
+{
+    long           numOriginal = code->numOriginal, i;
+    long         * newIndex = codePositions(code);
+    unsigned int * words = malloc((code->numInstrs + 1) *
+                                  sizeof(unsigned int));
+    int          * lineNums = malloc((code->numInstrs + 1) * sizeof(int));
+    InstrInfo      info;
+
+    if ( newIndex == NULL || words == NULL || lineNums == NULL )
+    {
+        if ( newIndex != NULL )
+            printError("Error: cannot allocate space in memory.\n");
+        free(newIndex);
+        free(words);
+        free(lineNums);
+        return 0;
+    }
+
+    for ( i = 0; i < code->numInstrs; i++ )
+    {
+        const CodeInstr * instr = &code->instrs[i];
+        long              target = instr->target;
+
+        words[i] = instr->word;
+        lineNums[i] = instr->lineNum;
+        if ( target < 0 )
+            continue;
+
+        /* A target outside the original program stays where it was. */
+        if ( target % 4 == 0 && target / 4 <= numOriginal )
+            target = 4 * newIndex[target / 4];
+        instrInfo(instr->word, 4 * i, &info);
+        if ( info.flags & INFO_BRANCH )
+        {
+            long offset = (target - 4 * (i + 1)) / 4;
+
+            if ( offset < -32768 || offset > 32767 )
+            {
+                printError("Error: line %d: the branch at address %ld is "
+                           "now too far from its target.\n", instr->lineNum,
+                           4 * i);
+                free(newIndex);
+                free(words);
+                free(lineNums);
+                return 0;
+            }
+            words[i] = (words[i] & 0xFFFF0000U) |
+                       ((unsigned int) offset & 0xFFFF);
+        }
+        else
+            words[i] = (words[i] & 0xFC000000U) |
+                       ((unsigned int) (target >> 2) & 0x3FFFFFF);
+    }
+
+    for ( i = 0; i < table->nbrLabels; i++ )
+    {
+        long address = table->addresses[i];
+
+        if ( address >= 0 && address % 4 == 0 && address / 4 <= numOriginal )
+            table->addresses[i] = (int) (4 * newIndex[address / 4]);
+    }
+
+    free(image->words);
+    free(image->lineNums);
+    image->words = words;
+    image->lineNums = lineNums;
+    image->numWords = (int) code->numInstrs;
+    free(newIndex);
+    return 1;
+}
+
+void codeFree (Code * code)
+{
+    free(code->instrs);
+    code->instrs = NULL;
+    code->numInstrs = code->numOriginal = 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Transform: an assembled program (an image; see image.h) taken apart so
+ * that instructions can be moved, inserted, and deleted, and then put
+ * back together.
+ *
+ * While a program is taken apart, each branch and direct jump holds the
+ * address, in the original program, of the instruction it goes to,
+ * rather than an offset or target field, and each instruction remembers
+ * where it was.  When the program is put back together, every branch
+ * offset, jump target, and label address is derived again from where
+ * those instructions ended up.  A label, or branch or jump target, on an
+ * instruction that was deleted moves to the next instruction that was
+ * not.
+ *
+ * An instruction is pinned if something refers to it by address (a
+ * label, or a branch or jump): it starts a basic block, and the
+ * transformations keep it at the start of its block.  Blocks also start
+ * after each branch and jump.
+ *
+ * The transformations are run in the order of their prototypes below.
+ * Each reports what it did to statsFp (if it is not NULL).
+ *
+ * Include assembler.h before this file.
+ *
+ * Creation Date:  10/19/2026
+ */
+
+#ifndef _TRANSFORM_H
+#define _TRANSFORM_H
+
+#include <stdio.h>
+
+#include "image.h"
+
+/* THE DATA STRUCTURES */
+
+typedef struct {
+        unsigned int word;
+        int          lineNum;   /* source line it came from */
+        long         origin;    /* its index in the original program;
+                                   -1 if it was inserted */
+        long         target;    /* original address a branch or direct
+                                   jump goes to; -1 for any other
+                                   instruction */
+        int          pinned;    /* 1 if a label, branch, or jump refers
+                                   to it */
+} CodeInstr;
+
+typedef struct {
+        CodeInstr * instrs;
+        long        numInstrs;
+        long        numOriginal;        /* instructions in the original
+                                           program */
+} Code;
+
+
+/* THE FUNCTIONS */
+
+int codeFromImage (Code * code, const Image * image,
+                   LabelTableArrayList * table);
+        /* Postcondition: code holds the instructions of image, whose
+         *      labels are in table, in order.
+         * Returns 1 if everything went OK; 0 if memory could not be
+         *      allocated (an error message has been printed).
+         */
+
+void codeReplace (Code * code, CodeInstr * instrs, long numInstrs);
+        /* Precondition: instrs was allocated with malloc.
+         * Postcondition: code holds the numInstrs instructions in
+         *      instrs, which it now owns, in place of those it held.
+         */
+
+long * codePositions (const Code * code);
+        /* Returns an array, allocated with malloc, of where each
+         *      instruction of the original program now is in code:
+         *      element i is the index of the instruction that was at
+         *      index i, or of the next one that was not deleted if it
+         *      was (numInstrs for none), and element numOriginal is
+         *      numInstrs.  Returns NULL if memory could not be
+         *      allocated (an error message has been printed).
+         */
+
+int codeToImage (Code * code, Image * image, LabelTableArrayList * table);
+        /* Postcondition: image holds the instructions in code, with
+         *      branch offsets and jump targets derived from where the
+         *      instructions they go to ended up, and the addresses of
+         *      the labels in table that were in the original program
+         *      moved with their instructions.
+         * Returns 1 if everything went OK; 0 if a branch offset no
+         *      longer fits in 16 bits or memory could not be allocated
+         *      (an error message has been printed, and image and table
+         *      are unchanged).
+         */
+
+void codeFree (Code * code);
+        /* Postcondition: the memory used by code has been released.
+         */
+
+int writeCfg (const Code * code, LabelTableArrayList * table, long entry,
+              FILE * out);
+        /* Postcondition: the control-flow graph of code (see cfg.c),
+         *      whose labels are in table, has been written to out in
+         *      the Graphviz dot language, with the blocks that cannot
+         *      be reached from the instruction at original address
+         *      entry drawn dashed.
+         * Returns 1 if everything went OK; 0 if memory could not be
+         *      allocated (an error message has been printed).
+         */
+
+long removeUnreachable (Code * code, long entry, FILE * statsFp);
+        /* Postcondition: the basic blocks of code that cannot be reached
+         *      from the instruction at original address entry have been
+         *      deleted.
+         * Returns the number of blocks deleted, or -1 if memory could
+         *      not be allocated (an error message has been printed, and
+         *      code is unchanged).
+         */
+
+long peephole (Code * code, FILE * statsFp);
+        /* Postcondition: wasteful instructions and pairs of instructions
+         *      in code (moves to self, jumps to the next instruction,
+         *      jumps to jumps) have been deleted or rewritten; pinned
+         *      instructions are kept.
+         * Returns the number of instructions saved, or -1 if memory
+         *      could not be allocated (an error message has been
+         *      printed).
+         */
+
+long scheduleBlocks (Code * code, int insertNops, FILE * statsFp);
+        /* Postcondition: the instructions in each basic block of code
+         *      have been reordered, as dependences allow, to keep loaded
+         *      values from being used right after their loads; if
+         *      insertNops is 1, a nop separates any that still are.
+         * Returns the number of instructions moved, or -1 if memory
+         *      could not be allocated (an error message has been
+         *      printed, and code is unchanged).
+         */
+
+long fillDelaySlots (Code * code, FILE * statsFp);
+        /* Postcondition: every branch and jump in code is followed by a
+         *      delay slot, filled by an independent instruction moved
+         *      from before it in its block, or else by a nop.
+         * Returns the number of slots filled with moved instructions, or
+         *      -1 if memory could not be allocated (an error message has
+         *      been printed, and code is unchanged).
+         */
+
+#endif